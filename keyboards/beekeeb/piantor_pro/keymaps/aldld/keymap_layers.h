@@ -0,0 +1,73 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_keymap.py from users/aldld/layout.json for beekeeb/piantor_pro. Do not edit.
+// Include from keymap.c only.
+
+#pragma once
+
+enum layers {
+    _BASE,
+    _NUM,
+    _SYM,
+    _NAV,
+    _MEDIA,
+    _VIM,
+};
+
+enum custom_keycodes {
+    RGB_SLD = SAFE_RANGE,
+    ST_MACRO_0,
+    ST_MACRO_1,
+    ST_MACRO_2,
+    MD_LINK,
+    CLN_EQ,
+    NEQ,
+    MAC_LOCK,
+};
+
+// clang-format off
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+[_BASE] = LAYOUT_split_3x6_3(
+  KC_TAB,               KC_Q,                 KC_W,                 KC_F,                 KC_P,                 KC_B,                 KC_J,                 KC_L,                 KC_U,                 KC_Y,                 KC_SCLN,              KC_BSLS,
+  ALL_T(KC_ESCAPE),     MT(MOD_LCTL, KC_A),   MT(MOD_LALT, KC_R),   MT(MOD_LGUI, KC_S),   MT(MOD_LSFT, KC_T),   KC_G,                 KC_M,                 MT(MOD_RSFT, KC_N),   MT(MOD_RGUI, KC_E),   MT(MOD_LALT, KC_I),   MT(MOD_RCTL, KC_O),   ALL_T(KC_QUOTE),
+  MEH_T(KC_GRAVE),      LT(_VIM, KC_Z),       KC_X,                 KC_C,                 KC_D,                 KC_V,                 KC_K,                 LT(_SYM, KC_H),       KC_COMMA,             KC_DOT,               KC_SLASH,             MEH_T(KC_EQUAL),
+  QK_BOOT,              LT(_NAV, KC_SPACE),   LT(_MEDIA, KC_MINUS), KC_BSPC,              LT(_NUM, KC_ENTER),   _______
+),
+
+[_NUM] = LAYOUT_split_3x6_3(
+  KC_UP,          KC_LBRC,        KC_7,           KC_8,           KC_9,           KC_RBRC,        _______,        _______,        _______,        _______,        _______,        _______,
+  LSFT(KC_G),     KC_COLN,        KC_4,           KC_5,           KC_6,           KC_EQUAL,       _______,        KC_RIGHT_SHIFT, KC_RIGHT_GUI,   KC_LEFT_ALT,    KC_RIGHT_CTRL,  KC_HYPR,
+  KC_DOWN,        KC_DOT,         KC_1,           KC_2,           KC_3,           KC_BSLS,        _______,        _______,        _______,        _______,        _______,        KC_MEH,
+  _______,        KC_0,           _______,        _______,        _______,        _______
+),
+
+[_SYM] = LAYOUT_split_3x6_3(
+  KC_LABK,        KC_LCBR,        KC_AMPR,        KC_ASTR,        KC_LPRN,        KC_RCBR,        _______,        _______,        _______,        _______,        _______,        _______,
+  KC_RABK,        KC_COLN,        KC_DLR,         KC_PERC,        KC_CIRC,        KC_PLUS,        _______,        KC_RIGHT_SHIFT, KC_RIGHT_GUI,   KC_LEFT_ALT,    KC_RIGHT_CTRL,  KC_HYPR,
+  KC_TILD,        KC_EQUAL,       KC_EXLM,        KC_AT,          KC_HASH,        KC_PIPE,        _______,        _______,        _______,        _______,        _______,        KC_MEH,
+  _______,        KC_RPRN,        _______,        _______,        _______,        _______
+),
+
+[_NAV] = LAYOUT_split_3x6_3(
+  _______,            _______,            _______,            _______,            _______,            _______,            LCTL(LSFT(KC_TAB)), HYPR(KC_LEFT),      HYPR(KC_DOWN),      HYPR(KC_UP),        HYPR(KC_RIGHT),     LCTL(KC_TAB),
+  KC_HYPR,            KC_LEFT_CTRL,       KC_LEFT_ALT,        KC_LEFT_GUI,        KC_LEFT_SHIFT,      _______,            _______,            KC_LEFT,            KC_DOWN,            KC_UP,              KC_RIGHT,           CW_TOGG,
+  KC_MEH,             _______,            _______,            _______,            _______,            _______,            _______,            KC_HOME,            KC_PGDN,            KC_PAGE_UP,         KC_END,             _______,
+  _______,            _______,            _______,            KC_DELETE,          KC_COLN,            _______
+),
+
+[_MEDIA] = LAYOUT_split_3x6_3(
+  _______,                LGUI(KC_Q),             LGUI(KC_W),             _______,                _______,                _______,                _______,                MEH(KC_LEFT),           _______,                _______,                MEH(KC_RIGHT),          _______,
+  _______,                LGUI(KC_A),             LGUI(KC_R),             LGUI(KC_S),             LGUI(KC_T),             ST_MACRO_0,             _______,                KC_MEDIA_PREV_TRACK,    KC_AUDIO_VOL_DOWN,      KC_AUDIO_VOL_UP,        KC_MEDIA_NEXT_TRACK,    _______,
+  _______,                KC_MAC_UNDO,            KC_MAC_CUT,             KC_MAC_COPY,            LGUI(LCTL(LSFT(KC_4))), KC_MAC_PASTE,           _______,                _______,                _______,                _______,                _______,                _______,
+  _______,                _______,                _______,                KC_AUDIO_MUTE,          KC_MEDIA_PLAY_PAUSE,    _______
+),
+
+[_VIM] = LAYOUT_split_3x6_3(
+  _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,
+  KC_HYPR,       KC_LEFT_CTRL,  KC_LEFT_ALT,   KC_LEFT_GUI,   KC_LEFT_SHIFT, _______,       ST_MACRO_1,    RCTL(KC_H),    LCTL(KC_J),    LCTL(KC_K),    LCTL(KC_L),    _______,
+  KC_MEH,        _______,       _______,       _______,       _______,       _______,       ST_MACRO_2,    LALT(KC_H),    LALT(KC_J),    LALT(KC_K),    LALT(KC_L),    _______,
+  _______,       _______,       _______,       _______,       _______,       _______
+)
+};
+// clang-format on
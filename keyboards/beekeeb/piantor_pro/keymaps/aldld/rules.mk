@@ -0,0 +1 @@
+MACRO_PLAYER_ENABLE = yes
@@ -2,9 +2,23 @@
     { 800, 1200, 1600 }
 #define PLOOPY_DPI_DEFAULT 1
 
-#define PLOOPY_DRAGSCROLL_INVERT
+// 16-bit motion, so that accelerated flicks fit in a report, see
+// users/aldld/pointer_accel.h.
+#define MOUSE_EXTENDED_REPORT
 
-#define PLOOPY_DRAGSCROLL_DIVISOR_H 60.0
-#define PLOOPY_DRAGSCROLL_DIVISOR_V 60.0
+// Drag scrolling is done by users/aldld/drag_scroll.c.
+#define DRAG_SCROLL_INVERT
+
+#define DRAG_SCROLL_DIVISOR_H 60
+#define DRAG_SCROLL_DIVISOR_V 60
+
+// Off: every report would be scaled by the resolution multiplier, whether
+// the host honours it or not, see users/aldld/drag_scroll.h.
+/*#define POINTING_DEVICE_HIRES_SCROLL_ENABLE*/
+
+// Read the sensor on every pass of the main loop, and send what was read once
+// per USB poll, see users/aldld/motion_coalesce.h.
+#undef POINTING_DEVICE_TASK_THROTTLE_MS
+#define POINTING_DEVICE_TASK_THROTTLE_MS 0
 
 /*#define PLOOPY_DRAGSCROLL_MOMENTARY*/
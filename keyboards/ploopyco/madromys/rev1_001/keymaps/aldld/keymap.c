@@ -17,6 +17,11 @@
  */
 #include "keycodes.h"
 #include QMK_KEYBOARD_H
+#include "dance.h"
+#include "drag_scroll.h"
+#include "motion_coalesce.h"
+#include "pointer_accel.h"
+#include "timer_service.h"
 
 // top left, top middle left, top middle right, top right, bottom left, bottom
 // right
@@ -38,24 +43,11 @@
 // activate drag scrolling with key
 //
 
-typedef enum {
-    TD_NONE,
-    TD_UNKNOWN,
-    TD_SINGLE_TAP,
-    TD_SINGLE_HOLD,
-    TD_DOUBLE_TAP,
-    TD_DOUBLE_HOLD,
-    TD_DOUBLE_SINGLE_TAP, // Send two single taps
-    TD_TRIPLE_TAP,
-    TD_TRIPLE_HOLD
-} td_state_t;
-
-td_state_t cur_dance(tap_dance_state_t *state);
-
-enum td_keycodes {
+enum custom_keycodes {
     // single tap: btn2
-    // hold: activate layer 1 and enable drag scroll
-    MSE_BTN2_DRAG,
+    // hold, or press and move the ball: activate layer 1 and enable drag
+    // scroll
+    MSE_BTN2_DRAG = SAFE_RANGE,
     LOCK_DRAG_SCROLL,
     BACK_FWD
 };
@@ -63,99 +55,101 @@ enum td_keycodes {
 // clang-format off
 const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     [0] = LAYOUT(
-        LGUI(LALT(KC_TAB)), TD(BACK_FWD), KC_BTN3,  TD(MSE_BTN2_DRAG),
+        LGUI(LALT(KC_TAB)), BACK_FWD, KC_BTN3,  MSE_BTN2_DRAG,
                  KC_BTN1, KC_BTN3 // TODO: Make this another btn2
     ),
     [1] = LAYOUT( // Activate by holding top right
         _______, _______, _______, _______,
-                 TD(LOCK_DRAG_SCROLL),  _______ // lock drag scroll
+                 LOCK_DRAG_SCROLL,  _______ // lock drag scroll
     )
 };
 // clang-format on
 
-extern bool is_drag_scroll;
-td_state_t  msbtn2_state           = TD_NONE;
-td_state_t  lock_drag_scroll_state = TD_NONE;
-bool        is_drag_scroll_locked  = false;
+// Sensor counts of motion while MSE_BTN2_DRAG is pressed that make it a hold
+// before the tapping term.
+#define MSE_BTN2_HOLD_MOTION 8
 
-void msebtn2_finished(tap_dance_state_t *state, void *user_data) {
-    msbtn2_state = cur_dance(state);
-    switch (msbtn2_state) {
-        case TD_SINGLE_HOLD:
-            is_drag_scroll = true;
-            layer_on(1);
-            break;
-        default:
-            break;
+bool     is_drag_scroll_locked = false;
+uint16_t msebtn2_motion        = 0;
+
+void btn2_or_unlock(bool pressed) {
+    if (is_drag_scroll_locked) {
+        if (pressed) {
+            is_drag_scroll_locked = false;
+            drag_scroll_set(false);
+        }
+    } else if (pressed) {
+        register_code16(KC_BTN2);
+    } else {
+        unregister_code16(KC_BTN2);
     }
 }
-void msebtn2_reset(tap_dance_state_t *state, void *user_data) {
-    switch (msbtn2_state) {
-        case TD_SINGLE_TAP:
-            if (is_drag_scroll_locked) {
-                is_drag_scroll_locked = false;
-                is_drag_scroll        = false;
-            } else {
-                tap_code16(KC_BTN2);
-            }
-            break;
-        case TD_SINGLE_HOLD:
-            if (!is_drag_scroll_locked) {
-                is_drag_scroll = false;
-            }
-            layer_off(1);
-            break;
-        default:
-            break;
+
+void drag_scroll_hold(bool pressed) {
+    if (pressed) {
+        drag_scroll_set(true);
+        layer_on(1);
+    } else {
+        if (!is_drag_scroll_locked) {
+            drag_scroll_set(false);
+        }
+        layer_off(1);
     }
 }
 
-void lock_drag_scroll_finished(tap_dance_state_t *state, void *user_data) {
-    lock_drag_scroll_state = cur_dance(state);
+void lock_drag_scroll(bool pressed) {
+    if (pressed) {
+        drag_scroll_set(true);
+        is_drag_scroll_locked = true;
+    }
 }
-void lock_drag_scroll_reset(tap_dance_state_t *state, void *user_data) {
-    switch (lock_drag_scroll_state) {
-        case TD_SINGLE_TAP:
-            is_drag_scroll        = true;
-            is_drag_scroll_locked = true;
-            break;
-        default:
-            break;
+
+// BACK_FWD keeps waiting for a second tap, the others fire on the first
+// release, or press.
+DANCE_TABLE(
+    [MSE_BTN2_DRAG - SAFE_RANGE]    = {.tap = {DANCE_FN(btn2_or_unlock)}, .hold = DANCE_FN(drag_scroll_hold)},
+    [LOCK_DRAG_SCROLL - SAFE_RANGE] = {.tap = {DANCE_FN(lock_drag_scroll)}},
+    [BACK_FWD - SAFE_RANGE]         = {.tap = {DANCE_KEY(LGUI(KC_LBRC)), DANCE_KEY(LGUI(KC_RBRC))}},
+);
+
+// Makes a press of MSE_BTN2_DRAG a hold as soon as the ball moves, rather
+// than at the tapping term. Until then, the motion doesn't move the pointer,
+// so that a right click lands where it was aimed.
+report_mouse_t btn2_motion_task(report_mouse_t report) {
+    if (!dance_can_hold(MSE_BTN2_DRAG)) {
+        msebtn2_motion = 0;
+        return report;
     }
+    msebtn2_motion += abs(report.x) + abs(report.y);
+    report.x = 0;
+    report.y = 0;
+    if (msebtn2_motion >= MSE_BTN2_HOLD_MOTION) {
+        dance_hold();
+    }
+    return report;
 }
 
-tap_dance_action_t tap_dance_actions[] = {
-    [MSE_BTN2_DRAG]    = ACTION_TAP_DANCE_FN_ADVANCED(NULL, msebtn2_finished, msebtn2_reset),
-    [LOCK_DRAG_SCROLL] = ACTION_TAP_DANCE_FN_ADVANCED(NULL, lock_drag_scroll_finished, lock_drag_scroll_reset),
-    [BACK_FWD]         = ACTION_TAP_DANCE_DOUBLE(LGUI(KC_LBRC), LGUI(KC_RBRC)),
+enum accel_curves {
+    CURVE_NORMAL,
+    CURVE_PRECISE,
 };
 
-td_state_t cur_dance(tap_dance_state_t *state) {
-    if (state->count == 1) {
-        if (state->interrupted || !state->pressed) return TD_SINGLE_TAP;
-        // Key has not been interrupted, but the key is still held. Means you want to send a 'HOLD'.
-        else
-            return TD_SINGLE_HOLD;
-    } else if (state->count == 2) {
-        // TD_DOUBLE_SINGLE_TAP is to distinguish between typing "pepper", and actually wanting a double tap
-        // action when hitting 'pp'. Suggested use case for this return value is when you want to send two
-        // keystrokes of the key, and not the 'double tap' action/macro.
-        if (state->interrupted)
-            return TD_DOUBLE_SINGLE_TAP;
-        else if (state->pressed)
-            return TD_DOUBLE_HOLD;
-        else
-            return TD_DOUBLE_TAP;
-    }
+// Gains in 1/256: 1x when slow up to 2.5x when fast on the base layer, and
+// finer control while drag scrolling on layer 1.
+POINTER_ACCEL_CURVES(
+    [CURVE_NORMAL]  = POINTER_ACCEL_CURVE(256, 640, 12),
+    [CURVE_PRECISE] = POINTER_ACCEL_CURVE(96, 256, 24),
+);
+POINTER_ACCEL_LAYERS([0] = CURVE_NORMAL, [1] = CURVE_PRECISE);
+
+report_mouse_t pointing_device_task_user(report_mouse_t mouse_report) {
+    return drag_scroll_task(pointer_accel_task(btn2_motion_task(motion_coalesce_task(mouse_report))));
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return process_dance(keycode, record);
+}
 
-    // Assumes no one is trying to type the same letter three times (at least not quickly).
-    // If your tap dance key is 'KC_W', and you want to type "www." quickly - then you will need to add
-    // an exception here to return a 'TD_TRIPLE_SINGLE_TAP', and define that enum just like 'TD_DOUBLE_SINGLE_TAP'
-    if (state->count == 3) {
-        if (state->interrupted || !state->pressed)
-            return TD_TRIPLE_TAP;
-        else
-            return TD_TRIPLE_HOLD;
-    } else
-        return TD_UNKNOWN;
+void housekeeping_task_user(void) {
+    timer_service_task();
 }
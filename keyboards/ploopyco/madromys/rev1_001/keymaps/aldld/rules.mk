@@ -1 +1,5 @@
-TAP_DANCE_ENABLE = yes
+DANCE_ENABLE = yes
+DRAG_SCROLL_ENABLE = yes
+POINTER_ACCEL_ENABLE = yes
+MOTION_COALESCE_ENABLE = yes
+HID_COMMANDS_ENABLE = yes
@@ -0,0 +1,98 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_chord_table.py from keyboards/zsa/voyager/keymaps/aldld/chord_table.json. Do not edit.
+
+#include QMK_KEYBOARD_H
+#include "chord_table.h"
+
+// clang-format off
+// Handedness of each key, for QMK's Chordal Hold.
+const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
+    LAYOUT_voyager(
+        'L', 'L', 'L', 'L', 'L', 'L', 'R', 'R', 'R', 'R', 'R', 'R',
+        'L', 'L', 'L', 'L', 'L', 'L', 'R', 'R', 'R', 'R', 'R', 'R',
+        'L', 'L', 'L', 'L', 'L', 'L', 'R', 'R', 'R', 'R', 'R', 'R',
+        'L', 'L', 'L', 'L', 'L', 'L', 'R', 'R', 'R', 'R', 'R', 'R',
+        '*', '*', '*', '*'
+    );
+
+// Position of each key in the layout plus one, or 0 for matrix positions that
+// are not in the layout.
+static const uint8_t chord_key_index[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
+    LAYOUT_voyager(
+         1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12,
+        13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+        25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36,
+        37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48,
+        49, 50, 51, 52
+    );
+
+// Row i has bit j set if key j chords with tap-hold key i, in layout order.
+static const uint8_t chord_bits[CHORD_TABLE_KEYS][7] PROGMEM = {
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 0
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 1
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 2
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 3
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 4
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 5
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 6
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 7
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 8
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 9
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 10
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 11
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 12
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 13
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 14
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 15
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 16
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 17
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 18
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 19
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 20
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 21
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 22
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 23
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 24
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 25
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 26
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 27
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 28
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 29
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 30
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 31
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 32
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 33
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 34
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 35
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 36
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 37
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 38
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 39
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 40
+    {0xC0, 0x0F, 0xFC, 0xC0, 0x0F, 0xFC, 0x0F}, // 41
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 42
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 43
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 44
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 45
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 46
+    {0x3F, 0xF0, 0x03, 0x3F, 0xF0, 0x03, 0x0F}, // 47
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, // 48
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, // 49
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, // 50
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}, // 51
+};
+// clang-format on
+
+bool chord_table_is_chord(keypos_t tap_hold_key, keypos_t other_key) {
+    if (tap_hold_key.row >= MATRIX_ROWS || tap_hold_key.col >= MATRIX_COLS || other_key.row >= MATRIX_ROWS || other_key.col >= MATRIX_COLS) {
+        return true;
+    }
+    const uint8_t i = pgm_read_byte(&chord_key_index[tap_hold_key.row][tap_hold_key.col]);
+    const uint8_t j = pgm_read_byte(&chord_key_index[other_key.row][other_key.col]);
+    if (i == 0 || j == 0) {
+        return true;
+    }
+    return pgm_read_byte(&chord_bits[i - 1][(j - 1) / 8]) & (1 << ((j - 1) % 8));
+}
@@ -0,0 +1,18 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_chord_table.py from keyboards/zsa/voyager/keymaps/aldld/chord_table.json. Do not edit.
+
+#pragma once
+
+#include "quantum.h"
+
+/** Number of keys in the layout. */
+#define CHORD_TABLE_KEYS 52
+
+/**
+ * Returns true if pressing the key at `other_key` while the tap-hold key at
+ * `tap_hold_key` is down is a chord, that is, the tap-hold key should be
+ * settled as held. Positions outside the layout always chord.
+ */
+bool chord_table_is_chord(keypos_t tap_hold_key, keypos_t other_key);
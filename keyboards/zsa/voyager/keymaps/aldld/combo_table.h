@@ -0,0 +1,45 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_combo_table.py from keyboards/zsa/voyager/keymaps/aldld/keymap_layers.h. Do not edit.
+// Include from keymap.c only, after key_combos[].
+
+#pragma once
+
+// Combos, in key_combos[] order:
+//   0 combo_fs
+//   1 combo_pt
+//   2 combo_ln
+//   3 combo_ue
+//   4 combo_az
+//   5 combo_zx
+#define COMBO_TABLE_COUNT 6
+
+uint32_t combo_table_lookup(uint16_t keycode) {
+    switch (keycode) {
+        case KC_F:
+            return 0x1;
+        case MT(MOD_LGUI, KC_S):
+            return 0x1;
+        case KC_P:
+            return 0x2;
+        case MT(MOD_LSFT, KC_T):
+            return 0x2;
+        case KC_L:
+            return 0x4;
+        case MT(MOD_RSFT, KC_N):
+            return 0x4;
+        case KC_U:
+            return 0x8;
+        case MT(MOD_RGUI, KC_E):
+            return 0x8;
+        case MT(MOD_LCTL, KC_A):
+            return 0x10;
+        case LT(_VIM, KC_Z):
+            return 0x30;
+        case KC_X:
+            return 0x20;
+        default:
+            return 0;
+    }
+}
@@ -11,11 +11,14 @@
     return false
 
 #define RGB_MATRIX_STARTUP_SPD 60
+#define RGB_MATRIX_DEFAULT_MODE RGB_MATRIX_CUSTOM_LAYER_INDICATOR
 
 #define CAPS_WORD_INVERT_ON_SHIFT
 #define CAPS_WORD_IDLE_TIMEOUT 5000
 
 /*#define ACHORDION_STREAK*/
+/*#define ACHORDION_STREAK_ADAPTIVE*/
+#define ACHORDION_CHORD_TABLE
 
 #define CHORDAL_HOLD
 
@@ -24,6 +27,9 @@
 #define TAPPING_TERM 320 // 220
 #define PERMISSIVE_HOLD
 
+#define ADAPTIVE_TERM_MAX_KEYS 12
+#define EECONFIG_USER_DATA_SIZE 64
+
 #define TAP_FLOW_TERM 200
 
 #define SELECT_WORD_OS_MAC
@@ -21,6 +21,22 @@
  */
 
 #include "achordion.h"
+#include "timer_service.h"
+
+#ifndef TIMER_SERVICE_ENABLE
+// Hold and streak timeouts are scheduled on users/aldld/timer_service.c.
+#error "achordion: set TIMER_SERVICE_ENABLE = yes in rules.mk."
+#endif
+
+#ifdef ACHORDION_CHORD_TABLE
+#include "chord_table.h"
+#endif
+
+#ifdef DECISION_TRACE_ENABLE
+#include "decision_trace.h"
+#else
+#define decision_trace(event, keycode, key, arg)
+#endif
 
 #if !defined(IS_QK_MOD_TAP)
 // Attempt to detect out-of-date QMK installation, which would fail with
@@ -28,266 +44,637 @@
 #error "achordion: QMK version is too old to build. Please update QMK."
 #else
 
-// Copy of the `record` and `keycode` args for the current active tap-hold key.
-static keyrecord_t tap_hold_record;
-static uint16_t tap_hold_keycode = KC_NO;
-// Timeout timer. When it expires, the key is considered held.
-static uint16_t hold_timer = 0;
-// Eagerly applied mods, if any.
-static uint8_t eager_mods = 0;
-// Flag to determine whether another key is pressed within the timeout.
-static bool pressed_another_key_before_release = false;
+#ifndef ACHORDION_MAX_PENDING
+#define ACHORDION_MAX_PENDING 4
+#endif
 
-#ifdef ACHORDION_STREAK
-// Timer for typing streak
-static uint16_t streak_timer = 0;
-#else
-// When disabled, is_streak is never true
-#define is_streak false
+#ifndef ACHORDION_OUTPUT_QUEUE_SIZE
+#define ACHORDION_OUTPUT_QUEUE_SIZE 8
 #endif
 
-// Achordion's current state.
+#ifndef ACHORDION_INPUT_QUEUE_SIZE
+#define ACHORDION_INPUT_QUEUE_SIZE 4
+#endif
+
+// Achordion's per-key state.
 enum {
   // A tap-hold key is pressed, but hasn't yet been settled as tapped or held.
   STATE_UNSETTLED,
-  // Achordion is inactive.
-  STATE_RELEASED,
-  // Active tap-hold key has been settled as tapped.
+  // Tap-hold key has been settled as tapped.
   STATE_TAPPING,
-  // Active tap-hold key has been settled as held.
+  // Tap-hold key has been settled as held.
   STATE_HOLDING,
-  // This state is set while calling `process_record()`, which will recursively
-  // call `process_achordion()`. This state is checked so that we don't process
-  // events generated by Achordion and potentially create an infinite loop.
-  STATE_RECURSING,
 };
-static uint8_t achordion_state = STATE_RELEASED;
+
+// A tap-hold key tracked by Achordion from its press until its release.
+typedef struct {
+  // Copy of the `record` and `keycode` args from the key's press.
+  keyrecord_t record;
+  uint16_t keycode;
+  // Timeout timer. When it expires, the key is considered held.
+  timer_token_t hold_timer;
+  // Identifies the key to its timer's callback, as keys move in `tap_holds`.
+  uint8_t id;
+  // Eagerly applied mods, if any.
+  uint8_t eager_mods;
+  // One of STATE_UNSETTLED, STATE_TAPPING, or STATE_HOLDING.
+  uint8_t state;
+  // Flag to determine whether another key is pressed within the timeout.
+  bool pressed_another_key_before_release;
+  // Flag set if the key was pressed while an earlier tap-hold key was still
+  // unsettled, i.e. as part of a roll.
+  bool pressed_during_roll;
+} tap_hold_t;
+
+// Tracked tap-hold keys, in the order they were pressed.
+static tap_hold_t tap_holds[ACHORDION_MAX_PENDING];
+static uint8_t num_tap_holds = 0;
+static uint8_t next_id = 0;
+// This flag is set while calling `process_record()`, which will recursively
+// call `process_achordion()`. It is checked so that we don't process events
+// generated by Achordion and potentially create an infinite loop.
+static bool recursing = false;
+
+// An event plumbed by Achordion, waiting to be sent to `process_record()`.
+typedef struct {
+  keyrecord_t record;
+  // The event is sent once this time is reached.
+  uint16_t send_time;
+  // Whether to send a keyboard report right after processing the event.
+  bool send_report;
+} plumbed_event_t;
+
+// Events plumbed by Achordion, in order. Rather than calling `process_record()`
+// while handling an event, plumbed events are queued here and sent from
+// `achordion_task()`, or before the next event is handled.
+static plumbed_event_t plumbed[ACHORDION_OUTPUT_QUEUE_SIZE];
+static uint8_t plumbed_head = 0;
+static uint8_t num_plumbed = 0;
+
+// An event that arrived while plumbed events were still waiting to be sent.
+typedef struct {
+  keyrecord_t record;
+  uint16_t keycode;
+} input_event_t;
+
+// Events that arrived while plumbed events were waiting, e.g. behind a tap
+// release held back by TAP_CODE_DELAY, in order. They are handled once the
+// plumbed events are sent, so that the host gets everything in order without
+// waiting for the release.
+static input_event_t inputs[ACHORDION_INPUT_QUEUE_SIZE];
+static uint8_t inputs_head = 0;
+static uint8_t num_inputs = 0;
+
+#ifdef ACHORDION_RELEASE_ORDER
+// Press of another key held back until the release order of it and the
+// unsettled tap-hold keys is known.
+static keyrecord_t deferred_record;
+static uint16_t deferred_keycode = KC_NO;
+static bool has_deferred_press = false;
+#endif
+
+#ifdef ACHORDION_STREAK
+// Timer for typing streak
+static uint16_t streak_timer = 0;
+// Timer that ends the streak after ACHORDION_STREAK_MAX_TIMEOUT.
+static timer_token_t streak_end_timer = TIMER_SERVICE_INVALID_TOKEN;
+
+#ifndef ACHORDION_STREAK_MAX_TIMEOUT
+#define ACHORDION_STREAK_MAX_TIMEOUT 800
+#endif
+
+#ifdef ACHORDION_STREAK_ADAPTIVE
+#ifndef ACHORDION_STREAK_ADAPTIVE_MIN
+#define ACHORDION_STREAK_ADAPTIVE_MIN 80
+#endif
+#ifndef ACHORDION_STREAK_ADAPTIVE_MAX
+#define ACHORDION_STREAK_ADAPTIVE_MAX 300
+#endif
+// Running average of the interval between presses while typing, on either
+// hand, kept per hand of the later press (index 0 left, 1 right), in units of
+// 1/16 ms. It is an exponentially weighted moving average with weight 1/8 for
+// each new interval.
+static uint16_t streak_interval[2] = {100 << 4, 100 << 4};
+static uint16_t last_press_time = 0;
+static bool on_left_hand(keypos_t pos);
+#endif  // ACHORDION_STREAK_ADAPTIVE
+#endif  // ACHORDION_STREAK
+
+// Returns the time left until `timeout` ms after `time`, which is less than
+// `timeout` for an event handled late, e.g. from the input queue.
+static uint16_t time_left(uint16_t time, uint16_t timeout) {
+  const uint16_t elapsed = timer_elapsed(time);
+  return elapsed < timeout ? timeout - elapsed : 0;
+}
 
 #ifdef ACHORDION_STREAK
+static uint32_t streak_expired(uint32_t deadline, void* arg) {
+  streak_end_timer = TIMER_SERVICE_INVALID_TOKEN;
+  streak_timer = 0;
+  return 0;
+}
+
 static void update_streak_timer(uint16_t keycode, keyrecord_t* record) {
+  timer_service_cancel(streak_end_timer);
+  streak_end_timer = TIMER_SERVICE_INVALID_TOKEN;
   if (achordion_streak_continue(keycode)) {
+    streak_end_timer = timer_service_start(
+        time_left(record->event.time, ACHORDION_STREAK_MAX_TIMEOUT),
+        streak_expired, NULL);
+  }
+  if (streak_end_timer != TIMER_SERVICE_INVALID_TOKEN) {
     // We use 0 to represent an unset timer, so `| 1` to force a nonzero value.
     streak_timer = record->event.time | 1;
   } else {
+    // Also when no timer is left to end the streak with.
     streak_timer = 0;
   }
 }
+
+#ifdef ACHORDION_STREAK_ADAPTIVE
+// Updates the typing speed estimate with a key press. Only keys that continue
+// a streak count, and pauses longer than ACHORDION_STREAK_MAX_TIMEOUT are
+// ignored, so that the estimate follows the speed of actual typing.
+static void update_streak_interval(uint16_t keycode, keyrecord_t* record) {
+  const uint16_t interval = record->event.time - last_press_time;
+  last_press_time = record->event.time;
+  if (interval <= ACHORDION_STREAK_MAX_TIMEOUT &&
+      achordion_streak_continue(keycode)) {
+    uint16_t* average = &streak_interval[!on_left_hand(record->event.key)];
+    *average += ((int16_t)(interval << 4) - (int16_t)*average) / 8;
+  }
+}
+
+// Streak timeout for keys on the same hand as `record`: twice the average
+// interval between presses, within the configured bounds.
+static uint16_t adaptive_streak_timeout(const keyrecord_t* record) {
+  const uint16_t timeout =
+      streak_interval[!on_left_hand(record->event.key)] >> 3;
+  if (timeout < ACHORDION_STREAK_ADAPTIVE_MIN) {
+    return ACHORDION_STREAK_ADAPTIVE_MIN;
+  }
+  return timeout < ACHORDION_STREAK_ADAPTIVE_MAX ? timeout
+                                                 : ACHORDION_STREAK_ADAPTIVE_MAX;
+}
+#endif  // ACHORDION_STREAK_ADAPTIVE
+
+// Returns true if `keycode` follows the tap-hold key `th` within a typing
+// streak.
+static bool is_streak(const tap_hold_t* th, uint16_t keycode,
+                      const keyrecord_t* record) {
+  uint16_t s_timeout = achordion_streak_chord_timeout(th->keycode, keycode);
+#ifdef ACHORDION_STREAK_ADAPTIVE
+  if (s_timeout) {  // A zero timeout still disables streaks for the pair.
+    s_timeout = adaptive_streak_timeout(&th->record);
+  }
 #endif
+  return streak_timer && s_timeout &&
+         !timer_expired(record->event.time, (streak_timer + s_timeout));
+}
+#else
+// When disabled, is_streak is never true
+#define is_streak(th, keycode, record) false
+#endif
+
+// Returns the tracked tap-hold key at the position of `record`, if any.
+static tap_hold_t* find_tap_hold(const keyrecord_t* record) {
+  if (!IS_KEYEVENT(record->event)) {
+    return NULL;
+  }
+  for (uint8_t i = 0; i < num_tap_holds; ++i) {
+    const keypos_t key = tap_holds[i].record.event.key;
+    if (key.row == record->event.key.row && key.col == record->event.key.col) {
+      return &tap_holds[i];
+    }
+  }
+  return NULL;
+}
+
+// Returns the number of tracked keys that are not yet settled.
+static uint8_t num_unsettled(void) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < num_tap_holds; ++i) {
+    n += tap_holds[i].state == STATE_UNSETTLED;
+  }
+  return n;
+}
 
 // Presses or releases eager_mods through process_action(), which skips the
 // usual event handling pipeline. The action is considered as a mod-tap hold or
 // release, with Retro Tapping if enabled.
-static void process_eager_mods_action(void) {
+static void process_eager_mods_action(tap_hold_t* th) {
   action_t action;
   action.code = ACTION_MODS_TAP_KEY(
-      eager_mods, QK_MOD_TAP_GET_TAP_KEYCODE(tap_hold_keycode));
-  process_action(&tap_hold_record, action);
+      th->eager_mods, QK_MOD_TAP_GET_TAP_KEYCODE(th->keycode));
+  process_action(&th->record, action);
 }
 
-// Calls `process_record()` with state set to RECURSING.
-static void recursively_process_record(keyrecord_t* record, uint8_t state) {
-  achordion_state = STATE_RECURSING;
+// Sends the oldest plumbed event to `process_record()` with the recursing flag
+// set.
+static void send_next_plumbed(void) {
+  plumbed_event_t event = plumbed[plumbed_head];
+  plumbed_head = (plumbed_head + 1) % ACHORDION_OUTPUT_QUEUE_SIZE;
+  --num_plumbed;
+
+  recursing = true;
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
   int8_t mouse_key_tracker = get_auto_mouse_key_tracker();
 #endif
-  process_record(record);
+  process_record(&event.record);
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
   set_auto_mouse_key_tracker(mouse_key_tracker);
 #endif
-  achordion_state = state;
+  recursing = false;
+
+  if (event.send_report) {
+    send_keyboard_report();
+  }
+}
+
+// Sends plumbed events whose time has come, in order. If `all` is true, every
+// plumbed event is sent. Should the oldest one not be due yet, e.g. a tap
+// release within TAP_CODE_DELAY of its press, the remaining time is waited out
+// so that the tap keeps its duration.
+static void send_plumbed(bool all) {
+  while (num_plumbed > 0) {
+    const uint16_t send_time = plumbed[plumbed_head].send_time;
+    if (!timer_expired(timer_read(), send_time)) {
+      if (!all) {
+        break;
+      }
+      wait_ms((uint16_t)(send_time - timer_read()));
+    }
+    send_next_plumbed();
+  }
+}
+
+// Queues a copy of `record` to be sent to `process_record()` `delay` ms from
+// now, after all events plumbed before it.
+static void plumb(const keyrecord_t* record, uint16_t delay,
+                  bool send_report) {
+  if (num_plumbed == ACHORDION_OUTPUT_QUEUE_SIZE) {
+    send_plumbed(true);  // Make room.
+  }
+  plumbed_event_t* event =
+      &plumbed[(plumbed_head + num_plumbed) % ACHORDION_OUTPUT_QUEUE_SIZE];
+  event->record = *record;
+  event->send_time = timer_read() + delay;
+  event->send_report = send_report;
+  ++num_plumbed;
+}
+
+// Converts a 5-bit mod code, as used in mod-tap keycodes, to an 8-bit mod
+// mask as used by `get_mods()`.
+static uint8_t mod_bits(uint8_t mods) {
+  return (mods & 0x10) ? (mods & 0x0f) << 4 : mods;
+}
+
+static void stop_hold_timer(tap_hold_t* th) {
+  timer_service_cancel(th->hold_timer);
+  th->hold_timer = TIMER_SERVICE_INVALID_TOKEN;
 }
 
-// Sends hold press event and settles the active tap-hold key as held.
-static void settle_as_hold(void) {
-  if (eager_mods) {
+// Sends hold press event and settles the tap-hold key as held.
+static void settle_as_hold(tap_hold_t* th, uint8_t reason) {
+  stop_hold_timer(th);
+  th->state = STATE_HOLDING;
+  decision_trace(TRACE_ACHORDION_HOLD, th->keycode, th->record.event.key,
+                 reason);
+  if (th->eager_mods) {
     // If eager mods are being applied, nothing needs to be done besides
     // updating the state.
     dprintln("Achordion: Settled eager mod as hold.");
-    achordion_state = STATE_HOLDING;
   } else {
     // Create hold press event.
     dprintln("Achordion: Plumbing hold press.");
-    recursively_process_record(&tap_hold_record, STATE_HOLDING);
+    plumb(&th->record, 0, false);
   }
 }
 
-// Sends tap press and release and settles the active tap-hold key as tapped.
-static void settle_as_tap(void) {
-  if (eager_mods) {  // Clear eager mods if set.
+// Sends tap press and release and settles the tap-hold key as tapped.
+static void settle_as_tap(tap_hold_t* th, uint8_t reason) {
+  stop_hold_timer(th);
+  th->state = STATE_TAPPING;
+  decision_trace(TRACE_ACHORDION_TAP, th->keycode, th->record.event.key,
+                 reason);
+  bool cleared_mods = false;
+  if (th->eager_mods) {  // Clear eager mods if set.
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY)
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
     neutralize_flashing_modifiers(get_mods());
 #endif  // DUMMY_MOD_NEUTRALIZER_KEYCODE
 #endif  // defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY)
-    tap_hold_record.event.pressed = false;
-    // To avoid falsely triggering Retro Tapping, process eager mods release as
-    // a regular mods release rather than a mod-tap release.
-    action_t action;
-    action.code = ACTION_MODS(eager_mods);
-    process_action(&tap_hold_record, action);
-    eager_mods = 0;
+    // Clear the mods without sending a report. The report for the tap press
+    // carries their release, so that the host gets one report instead of two
+    // and the tapped key isn't delayed. This also keeps Retro Tapping from
+    // seeing a mod-tap release.
+    del_mods(mod_bits(th->eager_mods));
+    decision_trace(TRACE_EAGER_CLEAR, th->keycode, th->record.event.key,
+                   th->eager_mods);
+    th->eager_mods = 0;
+    cleared_mods = true;
   }
 
   dprintln("Achordion: Plumbing tap press.");
-  tap_hold_record.event.pressed = true;
-  tap_hold_record.tap.count = 1;  // Revise event as a tap.
-  tap_hold_record.tap.interrupted = true;
-  // Plumb tap press event.
-  recursively_process_record(&tap_hold_record, STATE_TAPPING);
-
-  send_keyboard_report();
-#if TAP_CODE_DELAY > 0
-  wait_ms(TAP_CODE_DELAY);
-#endif  // TAP_CODE_DELAY > 0
+  th->record.event.pressed = true;
+  th->record.tap.count = 1;  // Revise event as a tap.
+  th->record.tap.interrupted = true;
+  // Plumb tap press event. If mods were cleared, it is followed by a keyboard
+  // report, in case the press itself sends none. Identical reports are not
+  // sent again, so this costs nothing otherwise.
+  plumb(&th->record, 0, cleared_mods);
 
   dprintln("Achordion: Plumbing tap release.");
-  tap_hold_record.event.pressed = false;
-  // Plumb tap release event.
-  recursively_process_record(&tap_hold_record, STATE_TAPPING);
+  th->record.event.pressed = false;
+  // Plumb tap release event. It is held back for TAP_CODE_DELAY ms without
+  // blocking, while the rest of the keyboard keeps running.
+  plumb(&th->record, TAP_CODE_DELAY, false);
 }
 
-bool process_achordion(uint16_t keycode, keyrecord_t* record) {
-  // Don't process events that Achordion generated.
-  if (achordion_state == STATE_RECURSING) {
-    return true;
-  }
-
-  // Determine whether the current event is for a mod-tap or layer-tap key.
-  const bool is_mt = IS_QK_MOD_TAP(keycode);
-  const bool is_tap_hold = is_mt || IS_QK_LAYER_TAP(keycode);
-  // Check that this is a normal key event, don't act on combos.
+// Settles the unsettled keys among the first `n` tracked keys, given that the
+// key `keycode` was pressed after them.
+//
+// If the other key is a tap-hold key considered by QMK to be held, then the
+// keys are settled as held. This way, things like chording multiple home row
+// mods will work.
+//
+// Otherwise, we call `achordion_chord()` to determine whether to settle each
+// tap-hold key as tapped vs. held. We implement the tap or hold by plumbing
+// events back into the handling pipeline so that QMK features and other user
+// code can see them. This is done by calling `process_record()`, which in turn
+// calls most handlers including `process_record_user()`.
+static void settle_before_key(uint8_t n, uint16_t keycode,
+                              keyrecord_t* record) {
   const bool is_key_event = IS_KEYEVENT(record->event);
+  const bool is_held_tap_hold =
+      (IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) &&
+      record->tap.count == 0;
+  bool settled_as_tap = false;
+
+  for (uint8_t i = 0; i < n; ++i) {
+    tap_hold_t* th = &tap_holds[i];
+    if (th->state != STATE_UNSETTLED) {
+      continue;
+    }
+    const bool streak = is_streak(th, keycode, record);
+    if (!streak &&
+        (!is_key_event || is_held_tap_hold ||
+         achordion_chord(th->keycode, &th->record, keycode, record))) {
+      settle_as_hold(th, ACHORDION_BY_CHORD);
 
-  // Event while no tap-hold key is active.
-  if (achordion_state == STATE_RELEASED) {
-    if (is_tap_hold && record->tap.count == 0 && record->event.pressed &&
-        is_key_event) {
-      // A tap-hold key is pressed and considered by QMK as "held".
-      const uint16_t timeout = achordion_timeout(keycode);
-      if (timeout > 0) {
-        achordion_state = STATE_UNSETTLED;
-        // Save info about this key.
-        tap_hold_keycode = keycode;
-        tap_hold_record = *record;
-        hold_timer = record->event.time + timeout;
-        pressed_another_key_before_release = false;
-        eager_mods = 0;
-
-        if (is_mt) {  // Apply mods immediately if they are "eager."
-          const uint8_t mod = mod_config(QK_MOD_TAP_GET_MODS(keycode));
-          if (
-#if defined(CAPS_WORD_ENABLE) && defined(CAPS_WORD_INVERT_ON_SHIFT)
-              // Since eager mods bypass normal event handling, eager Shift does
-              // not work with CAPS_WORD_INVERT_ON_SHIFT. So if this option is
-              // enabled, we don't apply Shift eagerly when Caps Word is on.
-              !(is_caps_word_on() && (mod & MOD_LSFT) != 0) &&
-#endif  // defined(CAPS_WORD_ENABLE) && defined(CAPS_WORD_INVERT_ON_SHIFT)
-              achordion_eager_mod(mod)) {
-            eager_mods = mod;
-            process_eager_mods_action();
-          }
-        }
-
-        dprintf("Achordion: Key 0x%04X pressed.%s\n", keycode,
-                eager_mods ? " Set eager mods." : "");
-        return false;  // Skip default handling.
+#ifdef REPEAT_KEY_ENABLE
+      // Edge case involving LT + Repeat Key: in a sequence of "LT down, other
+      // down" where "other" is on the other layer in the same position as
+      // Repeat or Alternate Repeat, the repeated keycode is set instead of the
+      // the one on the switched-to layer. Here we correct that.
+      if (get_repeat_key_count() != 0 && IS_QK_LAYER_TAP(th->keycode)) {
+        record->keycode = KC_NO;  // Forget the repeated keycode.
+        clear_weak_mods();
       }
+#endif  // REPEAT_KEY_ENABLE
+    } else {
+      settle_as_tap(th, streak ? ACHORDION_BY_STREAK : ACHORDION_BY_CHORD);
+      settled_as_tap = true;
     }
+  }
 
 #ifdef ACHORDION_STREAK
+  if (settled_as_tap) {
     update_streak_timer(keycode, record);
+  }
+#else
+  (void)settled_as_tap;
 #endif
-    return true;  // Otherwise, continue with default handling.
-  } else if (record->event.pressed && tap_hold_keycode != keycode) {
-    // Track whether another key was pressed while using a tap-hold key.
-    pressed_another_key_before_release = true;
-  }
-
-  // Release of the active tap-hold key.
-  if (keycode == tap_hold_keycode && !record->event.pressed) {
-    if (eager_mods) {
-      dprintln("Achordion: Key released. Clearing eager mods.");
-      tap_hold_record.event.pressed = false;
-      process_eager_mods_action();
-    } else if (achordion_state == STATE_HOLDING) {
-      dprintln("Achordion: Key released. Plumbing hold release.");
-      tap_hold_record.event.pressed = false;
-      // Plumb hold release event.
-      recursively_process_record(&tap_hold_record, STATE_RELEASED);
-    } else if (!pressed_another_key_before_release) {
-      // No other key was pressed between the press and release of the tap-hold
-      // key, plumb a hold press and then a release.
-      dprintln("Achordion: Key released. Plumbing hold press and release.");
-      recursively_process_record(&tap_hold_record, STATE_HOLDING);
-      tap_hold_record.event.pressed = false;
-      recursively_process_record(&tap_hold_record, STATE_RELEASED);
-    } else {
-      dprintln("Achordion: Key released.");
+}
+
+static uint32_t hold_expired(uint32_t deadline, void* arg);
+
+// Starts tracking a tap-hold key that QMK considers held.
+static void track_tap_hold(uint16_t keycode, keyrecord_t* record,
+                           uint16_t timeout) {
+  // Mods are applied eagerly only if no other key is unsettled. Otherwise they
+  // would leak into that key's tap if it settles as tapped.
+  const bool may_apply_eager_mods = num_unsettled() == 0;
+  const bool during_roll = !may_apply_eager_mods;
+  tap_hold_t* th = &tap_holds[num_tap_holds++];
+  // Save info about this key.
+  th->record = *record;
+  th->keycode = keycode;
+  th->id = next_id++;
+  // If no timer is left, the key waits for the next key or its release to
+  // settle it, as if its timeout were long.
+  th->hold_timer =
+      timer_service_start(time_left(record->event.time, timeout), hold_expired,
+                          (void*)(uintptr_t)th->id);
+  th->eager_mods = 0;
+  th->state = STATE_UNSETTLED;
+  th->pressed_another_key_before_release = false;
+  th->pressed_during_roll = during_roll;
+
+  if (IS_QK_MOD_TAP(keycode) && may_apply_eager_mods) {
+    // Apply mods immediately if they are "eager."
+    const uint8_t mod = mod_config(QK_MOD_TAP_GET_MODS(keycode));
+    if (
+#if defined(CAPS_WORD_ENABLE) && defined(CAPS_WORD_INVERT_ON_SHIFT)
+        // Since eager mods bypass normal event handling, eager Shift does
+        // not work with CAPS_WORD_INVERT_ON_SHIFT. So if this option is
+        // enabled, we don't apply Shift eagerly when Caps Word is on.
+        !(is_caps_word_on() && (mod & MOD_LSFT) != 0) &&
+#endif  // defined(CAPS_WORD_ENABLE) && defined(CAPS_WORD_INVERT_ON_SHIFT)
+        achordion_eager_mod(mod)) {
+      th->eager_mods = mod;
+      process_eager_mods_action(th);
+      decision_trace(TRACE_EAGER_APPLY, keycode, record->event.key, mod);
+    }
+  }
+  decision_trace(TRACE_ACHORDION_TRACK, keycode, record->event.key,
+                 num_tap_holds);
+
+  dprintf("Achordion: Key 0x%04X pressed.%s\n", keycode,
+          th->eager_mods ? " Set eager mods." : "");
+}
+
+// Handles the release of a tracked tap-hold key and stops tracking it.
+static void release_tap_hold(tap_hold_t* th) {
+  if (th->state == STATE_UNSETTLED) {
+    // Keys pressed before this one are settled first, as if this key had been
+    // pressed again, so that events reach the host in order.
+    settle_before_key(th - tap_holds, th->keycode, &th->record);
+  }
+
+  if (th->state == STATE_UNSETTLED &&
+      (th->pressed_another_key_before_release || th->pressed_during_roll)) {
+    // A tap-hold key pressed after this one is still unsettled, or this one
+    // was pressed while an earlier one was, meaning the keys were rolled.
+    // Settle this one as tapped.
+    dprintln("Achordion: Key released during a roll. Plumbing tap.");
+    settle_as_tap(th, ACHORDION_BY_ROLL);
+  } else if (th->eager_mods) {
+    dprintln("Achordion: Key released. Clearing eager mods.");
+    if (th->state == STATE_UNSETTLED) {
+      decision_trace(TRACE_ACHORDION_HOLD, th->keycode, th->record.event.key,
+                     ACHORDION_BY_RELEASE);
     }
+    th->record.event.pressed = false;
+    process_eager_mods_action(th);
+    decision_trace(TRACE_EAGER_CLEAR, th->keycode, th->record.event.key,
+                   th->eager_mods);
+  } else if (th->state == STATE_HOLDING) {
+    dprintln("Achordion: Key released. Plumbing hold release.");
+    th->record.event.pressed = false;
+    // Plumb hold release event.
+    plumb(&th->record, 0, false);
+  } else if (th->state == STATE_UNSETTLED) {
+    // No other key was pressed between the press and release of the tap-hold
+    // key, plumb a hold press and then a release.
+    dprintln("Achordion: Key released. Plumbing hold press and release.");
+    decision_trace(TRACE_ACHORDION_HOLD, th->keycode, th->record.event.key,
+                   ACHORDION_BY_RELEASE);
+    plumb(&th->record, 0, false);
+    th->record.event.pressed = false;
+    plumb(&th->record, 0, false);
+  } else {
+    dprintln("Achordion: Key released.");
+  }
+
+  stop_hold_timer(th);
+  --num_tap_holds;
+  for (tap_hold_t* next = th + 1; next <= &tap_holds[num_tap_holds]; ++next) {
+    next[-1] = *next;
+  }
+}
 
-    achordion_state = STATE_RELEASED;
-    tap_hold_keycode = KC_NO;
+#ifdef ACHORDION_RELEASE_ORDER
+// Returns true if the press of `keycode` should be held back until the release
+// order tells whether the unsettled keys are tapped or held. That is the case
+// when `achordion_chord()` doesn't already settle all of them as held.
+static bool should_defer_press(uint16_t keycode, keyrecord_t* record) {
+  if (has_deferred_press || !IS_KEYEVENT(record->event) ||
+      ((IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) &&
+       record->tap.count == 0)) {
     return false;
   }
+  bool all_held = true;
+  for (uint8_t i = 0; i < num_tap_holds; ++i) {
+    tap_hold_t* th = &tap_holds[i];
+    if (th->state != STATE_UNSETTLED) {
+      continue;
+    }
+    if (is_streak(th, keycode, record)) {
+      return false;
+    }
+    all_held = all_held &&
+               achordion_chord(th->keycode, &th->record, keycode, record);
+  }
+  return !all_held;
+}
 
-  if (achordion_state == STATE_UNSETTLED && record->event.pressed) {
-#ifdef ACHORDION_STREAK
-    const uint16_t s_timeout =
-        achordion_streak_chord_timeout(tap_hold_keycode, keycode);
-    const bool is_streak =
-        streak_timer && s_timeout &&
-        !timer_expired(record->event.time, (streak_timer + s_timeout));
+// Stops waiting on release order. The unsettled keys are settled as usual,
+// then the deferred press is plumbed.
+static void send_deferred_press(void) {
+  if (has_deferred_press) {
+    has_deferred_press = false;
+    settle_before_key(num_tap_holds, deferred_keycode, &deferred_record);
+    plumb(&deferred_record, 0, false);
+  }
+}
+#endif  // ACHORDION_RELEASE_ORDER
+
+// Handles an event, once the events plumbed before it were sent. Returns true
+// to continue with default handling.
+static bool handle_event(uint16_t keycode, keyrecord_t* record) {
+#if defined(ACHORDION_STREAK) && defined(ACHORDION_STREAK_ADAPTIVE)
+  if (record->event.pressed && IS_KEYEVENT(record->event)) {
+    update_streak_interval(keycode, record);
+  }
 #endif
 
-    // Press event occurred on a key other than the active tap-hold key.
-
-    // If the other key is *also* a tap-hold key and considered by QMK to be
-    // held, then we settle the active key as held. This way, things like
-    // chording multiple home row modifiers will work, but let's our logic
-    // consider simply a single tap-hold key as "active" at a time.
-    //
-    // Otherwise, we call `achordion_chord()` to determine whether to settle the
-    // tap-hold key as tapped vs. held. We implement the tap or hold by plumbing
-    // events back into the handling pipeline so that QMK features and other
-    // user code can see them. This is done by calling `process_record()`, which
-    // in turn calls most handlers including `process_record_user()`.
-    if (!is_streak &&
-        (!is_key_event || (is_tap_hold && record->tap.count == 0) ||
-         achordion_chord(tap_hold_keycode, &tap_hold_record, keycode,
-                         record))) {
-      settle_as_hold();
+  // Release of a tracked tap-hold key.
+  tap_hold_t* th = find_tap_hold(record);
+  if (th != NULL && !record->event.pressed) {
+    release_tap_hold(th);
+#ifdef ACHORDION_RELEASE_ORDER
+    if (num_unsettled() == 0) {
+      // Tap-hold keys released first were settled as tapped.
+      send_deferred_press();
+    }
+#endif
+    return false;
+  }
 
-#ifdef REPEAT_KEY_ENABLE
-      // Edge case involving LT + Repeat Key: in a sequence of "LT down, other
-      // down" where "other" is on the other layer in the same position as
-      // Repeat or Alternate Repeat, the repeated keycode is set instead of the
-      // the one on the switched-to layer. Here we correct that.
-      if (get_repeat_key_count() != 0 && IS_QK_LAYER_TAP(tap_hold_keycode)) {
-        record->keycode = KC_NO;  // Forget the repeated keycode.
-        clear_weak_mods();
+#ifdef ACHORDION_RELEASE_ORDER
+  if (has_deferred_press && !record->event.pressed &&
+      IS_KEYEVENT(record->event) &&
+      record->event.key.row == deferred_record.event.key.row &&
+      record->event.key.col == deferred_record.event.key.col) {
+    // The other key was pressed and released while the unsettled keys are
+    // still held, so they are settled as held.
+    dprintln("Achordion: Nested press and release. Settling as hold.");
+    for (uint8_t i = 0; i < num_tap_holds; ++i) {
+      if (tap_holds[i].state == STATE_UNSETTLED) {
+        settle_as_hold(&tap_holds[i], ACHORDION_BY_RELEASE_ORDER);
       }
-#endif  // REPEAT_KEY_ENABLE
-    } else {
-      settle_as_tap();
+    }
+    has_deferred_press = false;
+    plumb(&deferred_record, 0, false);
+    plumb(record, 0, false);
+    return false;
+  }
+#endif
 
+  if (record->event.pressed) {
+    // Track whether another key was pressed while using a tap-hold key.
+    for (uint8_t i = 0; i < num_tap_holds; ++i) {
+      tap_holds[i].pressed_another_key_before_release = true;
+    }
+#ifdef ACHORDION_RELEASE_ORDER
+    // A further press ends the wait on release order.
+    send_deferred_press();
+#endif
+  }
+
+  // Determine whether the current event is for a mod-tap or layer-tap key.
+  const bool is_tap_hold = IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode);
+  // Check that this is a normal key event, don't act on combos.
+  const bool is_key_event = IS_KEYEVENT(record->event);
+
+  if (is_tap_hold && record->tap.count == 0 && record->event.pressed &&
+      is_key_event && num_tap_holds < ACHORDION_MAX_PENDING) {
+    // A tap-hold key is pressed and considered by QMK as "held".
+    const uint16_t timeout = achordion_timeout(keycode);
+    if (timeout > 0) {
 #ifdef ACHORDION_STREAK
-      update_streak_timer(keycode, record);
-      if (is_streak && is_key_event && is_tap_hold && record->tap.count == 0) {
-        // If we are in a streak and resolved the current tap-hold key as a tap
-        // consider the next tap-hold key as active to be resolved next.
-        update_streak_timer(tap_hold_keycode, &tap_hold_record);
-        const uint16_t timeout = achordion_timeout(keycode);
-        tap_hold_keycode = keycode;
-        tap_hold_record = *record;
-        hold_timer = record->event.time + timeout;
-        achordion_state = STATE_UNSETTLED;
-        pressed_another_key_before_release = false;
-        return false;
+      // Within a typing streak, keys still unsettled are settled as tapped.
+      // The others are left to be settled along with the new key.
+      for (uint8_t i = 0; i < num_tap_holds; ++i) {
+        tap_hold_t* other = &tap_holds[i];
+        if (other->state == STATE_UNSETTLED &&
+            is_streak(other, keycode, record)) {
+          settle_as_tap(other, ACHORDION_BY_STREAK);
+          update_streak_timer(other->keycode, &other->record);
+        }
       }
 #endif
+      track_tap_hold(keycode, record, timeout);
+      return false;  // Skip default handling.
     }
+  }
 
-    recursively_process_record(record, achordion_state);  // Re-process event.
+  if (record->event.pressed && num_unsettled() > 0) {
+#ifdef ACHORDION_RELEASE_ORDER
+    if (should_defer_press(keycode, record)) {
+      dprintln("Achordion: Deferring press until release order is known.");
+      deferred_record = *record;
+      deferred_keycode = keycode;
+      has_deferred_press = true;
+      return false;  // Block the original event.
+    }
+#endif
+    // Press event occurred on a key other than the tracked tap-hold keys, or
+    // on a tap-hold key that can't be tracked. Settle the tracked keys, then
+    // re-process the event.
+    settle_before_key(num_tap_holds, keycode, record);
+    plumb(record, 0, false);  // Re-process event after the settled keys.
     return false;  // Block the original event.
   }
 
@@ -295,24 +682,84 @@ bool process_achordion(uint16_t keycode, keyrecord_t* record) {
   // update idle timer on regular keys event
   update_streak_timer(keycode, record);
 #endif
-  return true;
+  return true;  // Otherwise, continue with default handling.
 }
 
-void achordion_task(void) {
-  if (achordion_state == STATE_UNSETTLED &&
-      timer_expired(timer_read(), hold_timer)) {
-    settle_as_hold();  // Timeout expired, settle the key as held.
+// Handles the queued events in order, as long as nothing plumbed is waiting
+// to be sent before them. If `all` is true, plumbed events that aren't due yet
+// are waited for, so that the input queue is empty afterwards.
+static void handle_inputs(bool all) {
+  for (;;) {
+    send_plumbed(all);
+    if (num_plumbed > 0 || num_inputs == 0) {
+      return;
+    }
+    input_event_t input = inputs[inputs_head];
+    inputs_head = (inputs_head + 1) % ACHORDION_INPUT_QUEUE_SIZE;
+    --num_inputs;
+    if (handle_event(input.keycode, &input.record)) {
+      // Continue with default handling, late.
+      plumb(&input.record, 0, false);
+    }
   }
+}
 
-#ifdef ACHORDION_STREAK
-#define MAX_STREAK_TIMEOUT 800
-  if (streak_timer &&
-      timer_expired(timer_read(), (streak_timer + MAX_STREAK_TIMEOUT))) {
-    streak_timer = 0;  // Expired.
+bool process_achordion(uint16_t keycode, keyrecord_t* record) {
+  // Don't process events that Achordion generated.
+  if (recursing) {
+    return true;
+  }
+  // Events plumbed earlier must reach the rest of the pipeline first. Those
+  // that are due are sent now. If some aren't, the event waits behind them in
+  // the input queue, rather than blocking until they are.
+  handle_inputs(false);
+  if (num_plumbed > 0 || num_inputs > 0) {
+    if (num_inputs == ACHORDION_INPUT_QUEUE_SIZE) {
+      handle_inputs(true);  // Make room.
+    }
+    if (num_plumbed > 0 || num_inputs > 0) {
+      input_event_t* input =
+          &inputs[(inputs_head + num_inputs) % ACHORDION_INPUT_QUEUE_SIZE];
+      input->record = *record;
+      input->keycode = keycode;
+      ++num_inputs;
+      return false;  // Block the original event.
+    }
+  }
+  return handle_event(keycode, record);
+}
+
+bool achordion_plumbing(void) { return recursing; }
+
+// Settles the key with id `arg`, whose timeout expired, as held. Keys pressed
+// before it are settled as held too, so that events reach the host in order.
+static uint32_t hold_expired(uint32_t deadline, void* arg) {
+  // Events due before the timeout are handled first, and may release the key.
+  handle_inputs(false);
+  uint8_t expired = 0;
+  for (uint8_t i = 0; i < num_tap_holds; ++i) {
+    if (tap_holds[i].id == (uint8_t)(uintptr_t)arg) {
+      expired = i + 1;
+      break;
+    }
+  }
+  for (uint8_t i = 0; i < expired; ++i) {
+    if (tap_holds[i].state == STATE_UNSETTLED) {
+      // Timeout expired, settle as held.
+      settle_as_hold(&tap_holds[i], ACHORDION_BY_TIMEOUT);
+    }
+  }
+#ifdef ACHORDION_RELEASE_ORDER
+  if (num_unsettled() == 0) {
+    send_deferred_press();
   }
 #endif
+  handle_inputs(false);
+  return 0;
 }
 
+void achordion_task(void) { handle_inputs(false); }
+
 // Returns true if `pos` on the left hand of the keyboard, false if right.
 static bool on_left_hand(keypos_t pos) {
 #ifdef SPLIT_KEYBOARD
@@ -330,12 +777,18 @@ bool achordion_opposite_hands(const keyrecord_t* tap_hold_record,
 }
 
 // By default, use the BILATERAL_COMBINATIONS rule to consider the tap-hold key
-// "held" only when it and the other key are on opposite hands.
+// "held" only when it and the other key are on opposite hands. With a chord
+// table, the table decides, which also covers its per-pair exceptions.
 __attribute__((weak)) bool achordion_chord(uint16_t tap_hold_keycode,
                                            keyrecord_t* tap_hold_record,
                                            uint16_t other_keycode,
                                            keyrecord_t* other_record) {
+#ifdef ACHORDION_CHORD_TABLE
+  return chord_table_is_chord(tap_hold_record->event.key,
+                              other_record->event.key);
+#else
   return achordion_opposite_hands(tap_hold_record, other_record);
+#endif
 }
 
 // By default, the timeout is 1000 ms for all keys.
@@ -80,9 +80,30 @@ bool process_achordion(uint16_t keycode, keyrecord_t* record);
  *     void matrix_scan_user(void) {
  *       achordion_task();
  *     }
+ *
+ * Events that Achordion generates when settling keys are queued and sent to
+ * `process_record()` from this function rather than while the triggering event
+ * is being handled, so it should be called on every scan. The tap release is
+ * held back by TAP_CODE_DELAY without blocking. The queue holds 8 events by
+ * default, configurable with `#define ACHORDION_OUTPUT_QUEUE_SIZE 8`. Key
+ * events that arrive while a release is held back wait behind it in an input
+ * queue of 4 events, configurable with `#define ACHORDION_INPUT_QUEUE_SIZE 4`,
+ * and are handled from this function too. Achordion only waits for the
+ * release when one of the queues is full.
+ *
+ * Hold and streak timeouts are scheduled with users/aldld/timer_service.h,
+ * so enable it with `TIMER_SERVICE_ENABLE = yes` and call
+ * `timer_service_task()` from `housekeeping_task_user()` as well. Each
+ * tracked key takes a timer, and the streak another one.
  */
 void achordion_task(void);
 
+/**
+ * Returns true while Achordion sends an event it settled through
+ * `process_record()`, so that handlers can tell such events apart.
+ */
+bool achordion_plumbing(void);
+
 /**
  * Optional callback to customize which key chords are considered "held".
  *
@@ -157,6 +178,73 @@ bool achordion_eager_mod(uint8_t mod);
  */
 bool achordion_opposite_hands(const keyrecord_t* tap_hold_record, const keyrecord_t* other_record);
 
+/**
+ * Why a tap-hold key was settled as tapped or held. With DECISION_TRACE_ENABLE
+ * (see users/aldld/decision_trace.h), each decision is recorded along with
+ * its reason.
+ */
+enum achordion_reason {
+  /** By `achordion_chord()`, or because the next key was a held tap-hold. */
+  ACHORDION_BY_CHORD,
+  /** Within a typing streak. */
+  ACHORDION_BY_STREAK,
+  /** Released while a tap-hold key pressed after it was unsettled. */
+  ACHORDION_BY_ROLL,
+  /** Another key was pressed and released within it (release order mode). */
+  ACHORDION_BY_RELEASE_ORDER,
+  /** Released with no other key pressed. */
+  ACHORDION_BY_RELEASE,
+  /** The timeout expired. */
+  ACHORDION_BY_TIMEOUT,
+};
+
+/**
+ * With ACHORDION_CHORD_TABLE defined, the default `achordion_chord()` looks
+ * the pair of keys up in the keymap's generated chord table instead of
+ * comparing hands. The table is built from the keymap's chord_table.json by
+ * tools/gen_chord_table.py and can hold per-pair exceptions to the
+ * opposite-hands rule. Add chord_table.c to SRC in rules.mk and enable with:
+ *
+ *    #define ACHORDION_CHORD_TABLE
+ */
+
+/**
+ * Several tap-hold keys can be unsettled at once, for instance during a fast
+ * roll across home row mods. Each one is settled on its own: as tapped if it is
+ * released while a tap-hold key pressed after it is still unsettled, and
+ * otherwise by `achordion_chord()` or its timeout as usual.
+ *
+ * The number of tap-hold keys tracked at a time defaults to 4 and can be
+ * changed with:
+ *
+ *    #define ACHORDION_MAX_PENDING 4
+ *
+ * When all slots are in use, a further tap-hold key settles the unsettled keys
+ * as held and is itself handled as a regular hold.
+ */
+
+/**
+ * Settle on release order by defining ACHORDION_RELEASE_ORDER.
+ *
+ * By default, the next key press settles unsettled tap-hold keys right away
+ * through `achordion_chord()`. With this option, when `achordion_chord()`
+ * doesn't settle all of them as held, the other key's press is held back and
+ * the order of releases decides instead:
+ *
+ *  * If the other key is pressed and released while the tap-hold keys are
+ *    still held, they are settled as held, e.g. a same-hand shortcut.
+ *
+ *  * If a tap-hold key is released first, it is settled as tapped, e.g. a
+ *    roll.
+ *
+ * Nested presses then no longer depend on the timeout. A further key press, or
+ * the timeout, settles the keys through `achordion_chord()` as usual.
+ *
+ * Enable with:
+ *
+ *    #define ACHORDION_RELEASE_ORDER
+ */
+
 /**
  * Suppress tap-hold mods within a *typing streak* by defining
  * ACHORDION_STREAK. This can help preventing accidental mod
@@ -175,6 +263,20 @@ bool achordion_opposite_hands(const keyrecord_t* tap_hold_record, const keyrecor
  *        uint16_t tap_hold_keycode, uint16_t next_keycode) {
  *      return 200;  // Default of 200 ms.
  *    }
+ *
+ * A streak ends once no key is pressed for ACHORDION_STREAK_MAX_TIMEOUT ms
+ * (default 800).
+ *
+ * With ACHORDION_STREAK_ADAPTIVE also defined, the streak timeout follows the
+ * typing speed instead: it is twice a running average of the time from a
+ * press to the next press of a streak key, on either hand, bounded by
+ * ACHORDION_STREAK_ADAPTIVE_MIN and ACHORDION_STREAK_ADAPTIVE_MAX (default 80
+ * and 300 ms). The average is kept per hand, of the intervals ending on that
+ * hand, and the tap-hold key's hand decides which one applies. Intervals are
+ * not measured between presses on the same hand only, because alternating
+ * hands would then double them, and the timeout with them. `achordion_streak_chord_timeout()` then only decides which key
+ * pairs can form a streak: returning 0 disables streaks for the pair, and
+ * any other value is replaced with the adaptive timeout.
  */
 #ifdef ACHORDION_STREAK
 uint16_t achordion_streak_chord_timeout(uint16_t tap_hold_keycode, uint16_t next_keycode);
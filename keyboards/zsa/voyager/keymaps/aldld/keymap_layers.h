@@ -0,0 +1,113 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_keymap.py from users/aldld/layout.json for zsa/voyager. Do not edit.
+// Include from keymap.c only.
+
+#pragma once
+
+enum layers {
+    _BASE,
+    _NUM,
+    _SYM,
+    _NAV,
+    _MEDIA,
+    _VIM,
+};
+
+enum custom_keycodes {
+    RGB_SLD = SAFE_RANGE,
+    ST_MACRO_0,
+    ST_MACRO_1,
+    ST_MACRO_2,
+    MD_LINK,
+    CLN_EQ,
+    NEQ,
+    MAC_LOCK,
+};
+
+// clang-format off
+const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+[_BASE] = LAYOUT_voyager(
+  MAC_LOCK,             _______,              _______,              _______,              _______,              KC_BTN1,              _______,              KC_LBRC,              KC_RBRC,              _______,              _______,              _______,
+  KC_TAB,               KC_Q,                 KC_W,                 KC_F,                 KC_P,                 KC_B,                 KC_J,                 KC_L,                 KC_U,                 KC_Y,                 KC_SCLN,              KC_BSLS,
+  ALL_T(KC_ESCAPE),     MT(MOD_LCTL, KC_A),   MT(MOD_LALT, KC_R),   MT(MOD_LGUI, KC_S),   MT(MOD_LSFT, KC_T),   KC_G,                 KC_M,                 MT(MOD_RSFT, KC_N),   MT(MOD_RGUI, KC_E),   MT(MOD_LALT, KC_I),   MT(MOD_RCTL, KC_O),   ALL_T(KC_QUOTE),
+  MEH_T(KC_GRAVE),      LT(_VIM, KC_Z),       KC_X,                 KC_C,                 KC_D,                 KC_V,                 KC_K,                 LT(_SYM, KC_H),       KC_COMMA,             KC_DOT,               KC_SLASH,             MEH_T(KC_EQUAL),
+  LT(_NAV, KC_SPACE),   LT(_MEDIA, KC_MINUS), KC_BSPC,              LT(_NUM, KC_ENTER)
+),
+
+[_NUM] = LAYOUT_voyager(
+  _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,
+  KC_UP,          KC_LBRC,        KC_7,           KC_8,           KC_9,           KC_RBRC,        _______,        _______,        _______,        _______,        _______,        _______,
+  LSFT(KC_G),     KC_COLN,        KC_4,           KC_5,           KC_6,           KC_EQUAL,       _______,        KC_RIGHT_SHIFT, KC_RIGHT_GUI,   KC_LEFT_ALT,    KC_RIGHT_CTRL,  KC_HYPR,
+  KC_DOWN,        KC_GRAVE,       KC_1,           KC_2,           KC_3,           KC_BSLS,        _______,        _______,        _______,        _______,        _______,        KC_MEH,
+  KC_0,           _______,        _______,        _______
+),
+
+[_SYM] = LAYOUT_voyager(
+  _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,        _______,
+  KC_LABK,        KC_LCBR,        KC_AMPR,        KC_ASTR,        KC_LPRN,        KC_RCBR,        _______,        _______,        _______,        _______,        _______,        _______,
+  KC_RABK,        KC_COLN,        KC_DLR,         KC_PERC,        KC_CIRC,        KC_PLUS,        _______,        KC_RIGHT_SHIFT, KC_RIGHT_GUI,   KC_LEFT_ALT,    KC_RIGHT_CTRL,  KC_HYPR,
+  KC_TILD,        KC_EQUAL,       KC_EXLM,        KC_AT,          KC_HASH,        KC_PIPE,        _______,        _______,        _______,        _______,        _______,        KC_MEH,
+  KC_RPRN,        _______,        _______,        _______
+),
+
+[_NAV] = LAYOUT_voyager(
+  _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,                          _______,
+  _______,                          _______,                          _______,                          LCTL(LSFT(KC_TAB)),               LCTL(KC_TAB),                     _______,                          LCTL(LSFT(KC_TAB)),               LALT(LGUI(LCTL(LSFT(KC_LEFT)))),  LALT(LGUI(LCTL(LSFT(KC_DOWN)))),  LALT(LGUI(LCTL(LSFT(KC_UP)))),    LALT(LGUI(LCTL(LSFT(KC_RIGHT)))), LCTL(KC_TAB),
+  _______,                          KC_LEFT_CTRL,                     KC_LEFT_ALT,                      KC_LEFT_GUI,                      KC_LEFT_SHIFT,                    _______,                          _______,                          KC_LEFT,                          KC_DOWN,                          KC_UP,                            KC_RIGHT,                         CW_TOGG,
+  _______,                          _______,                          _______,                          SELECT_WORD_BACK,                 SELECT_WORD,                      _______,                          _______,                          KC_HOME,                          KC_PGDN,                          KC_PAGE_UP,                       KC_END,                           _______,
+  _______,                          _______,                          KC_DELETE,                        KC_COLN
+),
+
+[_MEDIA] = LAYOUT_voyager(
+  _______,                    _______,                    _______,                    _______,                    _______,                    _______,                    _______,                    _______,                    RGB_VAD,                    RGB_VAI,                    RGB_TOG,                    _______,
+  _______,                    LGUI(KC_Q),                 LGUI(KC_W),                 LCTL(LSFT(KC_TAB)),         LCTL(KC_TAB),               _______,                    _______,                    LALT(LCTL(LSFT(KC_LEFT))),  LALT(LCTL(LSFT(KC_DOWN))),  LALT(LCTL(LSFT(KC_UP))),    LALT(LCTL(LSFT(KC_RIGHT))), _______,
+  KC_HYPR,                    LGUI(KC_A),                 LGUI(KC_R),                 LGUI(KC_S),                 LGUI(KC_T),                 ST_MACRO_0,                 _______,                    KC_MEDIA_PREV_TRACK,        KC_AUDIO_VOL_DOWN,          KC_AUDIO_VOL_UP,            KC_MEDIA_NEXT_TRACK,        _______,
+  KC_MEH,                     KC_MAC_UNDO,                KC_MAC_CUT,                 KC_MAC_COPY,                LGUI(LCTL(LSFT(KC_4))),     KC_MAC_PASTE,               _______,                    SENTENCE_CASE_OFF,          SENTENCE_CASE_ON,           KC_BRMD,                    KC_BRMU,                    _______,
+  _______,                    _______,                    KC_AUDIO_MUTE,              KC_MEDIA_PLAY_PAUSE
+),
+
+[_VIM] = LAYOUT_voyager(
+  _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,       _______,
+  _______,       _______,       _______,       _______,       _______,       _______,       MD_LINK,       LALT(KC_LBRC), _______,       _______,       LALT(KC_RBRC), LALT(KC_BSLS),
+  _______,       _______,       _______,       _______,       _______,       _______,       ST_MACRO_1,    RCTL(KC_H),    LCTL(KC_J),    LCTL(KC_K),    LCTL(KC_L),    _______,
+  _______,       _______,       _______,       _______,       _______,       _______,       ST_MACRO_2,    LALT(KC_H),    LALT(KC_J),    LALT(KC_K),    LALT(KC_L),    _______,
+  _______,       _______,       _______,       _______
+)
+};
+// clang-format on
+
+const uint16_t PROGMEM combo_fs[] = {KC_F, MT(MOD_LGUI, KC_S), COMBO_END};
+const uint16_t PROGMEM combo_pt[] = {KC_P, MT(MOD_LSFT, KC_T), COMBO_END};
+const uint16_t PROGMEM combo_ln[] = {KC_L, MT(MOD_RSFT, KC_N), COMBO_END};
+const uint16_t PROGMEM combo_ue[] = {KC_U, MT(MOD_RGUI, KC_E), COMBO_END};
+const uint16_t PROGMEM combo_az[] = {MT(MOD_LCTL, KC_A), LT(_VIM, KC_Z), COMBO_END};
+const uint16_t PROGMEM combo_zx[] = {LT(_VIM, KC_Z), KC_X, COMBO_END};
+
+combo_t key_combos[] = {
+    COMBO(combo_fs, KC_LBRC),
+    COMBO(combo_pt, KC_RBRC),
+    COMBO(combo_ln, KC_LBRC),
+    COMBO(combo_ue, KC_RBRC),
+    COMBO(combo_az, CLN_EQ),
+    COMBO(combo_zx, NEQ),
+};
+
+// Tapping term per matrix position, or 0 for TAPPING_TERM.
+static const uint16_t keymap_tapping_terms[MATRIX_ROWS][MATRIX_COLS] PROGMEM = LAYOUT_voyager(
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+  0,   0,   0,   0,   155, 0,   0,   155, 0,   0,   0,   0,
+  0,   0,   0,   0,   0,   0,   0,   155, 0,   0,   0,   0,
+  155, 0,   0,   155
+);
+
+uint16_t keymap_tapping_term(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return TAPPING_TERM;
+    }
+    const uint16_t term = pgm_read_word(&keymap_tapping_terms[key.row][key.col]);
+    return term != 0 ? term : TAPPING_TERM;
+}
+
@@ -1,6 +1,9 @@
 # Set any rules.mk overrides for your specific keymap here.
 # See rules at https://docs.qmk.fm/#/config_options?id=the-rulesmk-file
+SRC += chord_table.c
+SRC += tap_flow_table.c
 # SRC += features/achordion.c
+# TIMER_SERVICE_ENABLE = yes # Needed by features/achordion.c.
 CONSOLE_ENABLE = no
 COMMAND_ENABLE = no
 MOUSEKEY_ENABLE = no
@@ -8,9 +11,18 @@ ORYX_ENABLE = yes
 RGB_MATRIX_CUSTOM_KB = no
 SPACE_CADET_ENABLE = no
 CAPS_WORD_ENABLE = yes
+MACRO_PLAYER_ENABLE = yes
 COMBO_ENABLE = yes
+COMBO_INDEX_ENABLE = yes
+ADAPTIVE_TERM_ENABLE = yes
+KEYMAP_CACHE_ENABLE = yes
+IDLE_MODE_ENABLE = yes
+LAYER_INDICATOR_ENABLE = yes
 REPEAT_KEY_ENABLE = yes
 # ACHORDION_ENABLE = yes
+# DECISION_TRACE_ENABLE = yes # Needs ORYX_ENABLE = no.
+# LATENCY_STATS_ENABLE = yes # Needs ORYX_ENABLE = no.
+# HID_COMMANDS_ENABLE = yes # Reads the stats above and idle mode's with tools/hid_tool. Needs ORYX_ENABLE = no.
 #
 #
 #
@@ -0,0 +1,84 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_tap_flow_table.py from keyboards/zsa/voyager/keymaps/aldld/tap_flow.json
+// and a corpus of 188 files, 2867986 bigrams. Do not edit.
+
+#include QMK_KEYBOARD_H
+#include "tap_flow_table.h"
+
+// clang-format off
+// Term per previous key class (a to z, then anything else) and tap-hold key,
+// in 1/15 of the tap flow term, two keys per byte, low nibble first.
+static const uint8_t tap_flow_levels[27][4] PROGMEM = {
+    {0xF0, 0xFF, 0x0F, 0x0C}, // a
+    {0x59, 0x03, 0xC0, 0x65}, // b
+    {0x7D, 0xF2, 0xF0, 0xF8}, // c
+    {0x5B, 0x07, 0xF0, 0xAE}, // d
+    {0xFE, 0xFF, 0x9F, 0x33}, // e
+    {0xA9, 0x03, 0x70, 0xEF}, // f
+    {0x62, 0x09, 0xD0, 0x17}, // g
+    {0x3D, 0x00, 0xF0, 0xBB}, // h
+    {0xA8, 0xFF, 0x9F, 0xF0}, // i
+    {0x00, 0x00, 0x70, 0x10}, // j
+    {0x00, 0x03, 0xB0, 0x03}, // k
+    {0x0E, 0x0C, 0xF1, 0xDF}, // l
+    {0x0E, 0x07, 0xF0, 0xC8}, // m
+    {0x0F, 0xFE, 0xF0, 0xF9}, // n
+    {0xF3, 0xEB, 0x1F, 0x65}, // o
+    {0xDE, 0xC2, 0xE0, 0xC7}, // p
+    {0x00, 0x00, 0x00, 0x00}, // q
+    {0xCF, 0x0C, 0xFE, 0xFF}, // r
+    {0x18, 0xFE, 0xF0, 0xAE}, // s
+    {0xFF, 0x0C, 0xF0, 0xFF}, // t
+    {0xF3, 0x0B, 0xCD, 0x05}, // u
+    {0x0C, 0x00, 0xE0, 0x06}, // v
+    {0x78, 0x01, 0x70, 0x7B}, // w
+    {0x02, 0xA0, 0x20, 0x03}, // x
+    {0x00, 0x77, 0x20, 0x51}, // y
+    {0x00, 0x00, 0x80, 0x02}, // z
+    {0xFF, 0x0F, 0xF0, 0xFF}, // other
+};
+// clang-format on
+
+static int8_t key_column(uint16_t keycode) {
+    switch (keycode) {
+        case MT(MOD_LCTL, KC_A):
+            return 0;
+        case MT(MOD_LALT, KC_R):
+            return 1;
+        case MT(MOD_LGUI, KC_S):
+            return 2;
+        case MT(MOD_LSFT, KC_T):
+            return 3;
+        case MT(MOD_RSFT, KC_N):
+            return 4;
+        case MT(MOD_RGUI, KC_E):
+            return 5;
+        case MT(MOD_LALT, KC_I):
+            return 6;
+        case MT(MOD_RCTL, KC_O):
+            return 7;
+        default:
+            return -1;
+    }
+}
+
+static uint8_t prev_class(uint16_t keycode) {
+    if (IS_QK_MOD_TAP(keycode)) {
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    } else if (IS_QK_LAYER_TAP(keycode)) {
+        keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }
+    return KC_A <= keycode && keycode <= KC_Z ? keycode - KC_A : 26;
+}
+
+uint16_t tap_flow_table_term(uint16_t keycode, uint16_t prev_keycode, uint16_t max_term) {
+    const int8_t col = key_column(keycode);
+    if (col < 0) {
+        return 0;
+    }
+    const uint8_t levels = pgm_read_byte(&tap_flow_levels[prev_class(prev_keycode)][col / 2]);
+    const uint8_t level  = col % 2 ? levels >> 4 : levels & 0x0F;
+    return (uint32_t)max_term * level / 15;
+}
@@ -0,0 +1,15 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_tap_flow_table.py from keyboards/zsa/voyager/keymaps/aldld/tap_flow.json
+// and a corpus of 188 files, 2867986 bigrams. Do not edit.
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * Returns the tap flow term for tap-hold key `keycode` pressed after
+ * `prev_keycode`, as a fraction of `max_term`, or 0 for keys not in the table.
+ */
+uint16_t tap_flow_table_term(uint16_t keycode, uint16_t prev_keycode, uint16_t max_term);
@@ -0,0 +1,128 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file bench.c
+ * @brief Times the pointer acceleration per report on the host.
+ *
+ * Links users/aldld/pointer_accel.c against the stub QMK API in
+ * tools/qmk_stub and runs it over a recorded-like stream of motion: bursts
+ * of slow and fast strokes in every direction, switching between two curves
+ * as if a layer were toggled every second. It prints the host time per
+ * report, and an estimate for the Madromys's RP2040 from it, compared with
+ * the time between two sensor reads.
+ *
+ * Usage:
+ *
+ *     accel_bench [-n reports] [-f factor] [-b budget_us]
+ *
+ * `factor` is how many times slower the MCU runs this code than the host,
+ * 50 by default, which is generous for a 125 MHz Cortex-M0+ against a
+ * desktop core running integer code. `budget_us` is the time between sensor
+ * reads. The Madromys sets POINTING_DEVICE_TASK_THROTTLE_MS 0, so it reads the
+ * sensor, and runs the pipeline, on every pass of the main loop. The default
+ * of 100 us is a pass at 10 kHz, on the fast side for the Madromys, so the
+ * budget is a tight one. The exit status is 1 if the estimate is over 1% of
+ * the budget.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pointer_accel.h"
+
+#define NUM_MOTIONS 4096
+// Reports per layer toggle, one second at 1 kHz.
+#define LAYER_PERIOD 1000
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 1;
+
+uint8_t get_highest_layer(layer_state_t state) {
+    uint8_t layer = 0;
+    while (state >>= 1) {
+        ++layer;
+    }
+    return layer;
+}
+
+POINTER_ACCEL_CURVES(POINTER_ACCEL_CURVE(256, 640, 12), POINTER_ACCEL_CURVE(96, 256, 24));
+POINTER_ACCEL_LAYERS([0] = 0, [1] = 1);
+
+static report_mouse_t motions[NUM_MOTIONS];
+
+static uint32_t xorshift(void) {
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Strokes of 20 to 200 reports, each at a steady speed of 0 to 60 counts
+// per report in a random direction.
+static void make_motions(void) {
+    for (int i = 0; i < NUM_MOTIONS;) {
+        const int length = 20 + xorshift() % 180;
+        const int speed  = xorshift() % 61;
+        const int dx     = (int)(xorshift() % 201) - 100;
+        const int dy     = (int)(xorshift() % 201) - 100;
+        for (int j = 0; j < length && i < NUM_MOTIONS; ++j, ++i) {
+            motions[i].x = dx * speed / 100;
+            motions[i].y = dy * speed / 100;
+        }
+    }
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    long   reports = 1000000;
+    double factor  = 50;
+    double budget  = 100;
+    for (int opt; (opt = getopt(argc, argv, "n:f:b:")) != -1;) {
+        switch (opt) {
+            case 'n':
+                reports = atol(optarg);
+                break;
+            case 'f':
+                factor = atof(optarg);
+                break;
+            case 'b':
+                budget = atof(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n reports] [-f factor] [-b budget_us]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (reports <= 0) {
+        fprintf(stderr, "reports must be positive\n");
+        return 2;
+    }
+
+    make_motions();
+    long in = 0, out = 0;
+
+    const double start = now_ns();
+    for (long i = 0; i < reports; ++i) {
+        layer_state                 = (i / LAYER_PERIOD) % 2 ? 2 : 0;
+        const report_mouse_t report = pointer_accel_task(motions[i % NUM_MOTIONS]);
+        in += abs(motions[i % NUM_MOTIONS].x) + abs(motions[i % NUM_MOTIONS].y);
+        out += abs(report.x) + abs(report.y);
+    }
+    const double host_ns = (now_ns() - start) / reports;
+
+    const double mcu_us = host_ns * factor / 1000;
+    const double share  = 100 * mcu_us / budget;
+    printf("%ld reports, %ld counts in, %ld out\n", reports, in, out);
+    printf("host:    %8.1f ns per report\n", host_ns);
+    printf("mcu:     %8.2f us per report (x%g)\n", mcu_us, factor);
+    printf("budget:  %8.0f us between sensor reads, %.3f%% used\n", budget, share);
+    return share > 1 ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file sim.c
+ * @brief Replays key-event traces through Achordion on the host.
+ *
+ * The simulator links features/achordion.c against the stub QMK API in
+ * tools/qmk_stub and plays back one or more trace files with a 1 ms clock,
+ * calling `process_achordion()` for each recorded event and `achordion_task()`
+ * after each event and once per tick, along with `timer_service_task()` from
+ * users/aldld/timer_service.c for Achordion's timeouts. For every tap-hold
+ * press it reports when the key settled as tapped or held and compares that
+ * with the expected outcome, if the trace gives one.
+ *
+ * Trace format, one event per line, `#` starts a comment:
+ *
+ *     <time ms> <row> <col> <keycode> <down|up> [tap=<count>] [expect=tap|hold]
+ *
+ * Events are the ones seen by `process_record_user()`, so a tap-hold press
+ * that QMK considers held has `tap=0` (the default). Keycodes are numbers in
+ * any base accepted by strtol(), e.g. `0x2816` for `MT(MOD_LGUI, KC_S)`.
+ *
+ * Usage:
+ *
+ *     achordion_sim [-v] trace...
+ *
+ * With -v, every event reaching the host is printed as well. Each trace is
+ * replayed in a child process so that it starts from a fresh Achordion state.
+ *
+ * Host reports are counted as in QMK, where a report identical to the last
+ * one sent is dropped. A report is made up of the mods and the keys down.
+ *
+ * Eagerly applied mods settle as held without sending anything to the host,
+ * so such decisions are reported at the next observable event: a later press
+ * or the key's release.
+ */
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "achordion.h"
+#include "timer_service.h"
+
+#define MAX_EVENTS 4096
+#define MAX_DECISIONS 1024
+// Extra time simulated after the last event so that pending timeouts expire.
+#define TAIL_MS 2000
+
+typedef struct {
+    uint16_t time;
+    keypos_t pos;
+    uint16_t keycode;
+    bool     pressed;
+    uint8_t  tap_count;
+    char     expect; // 'T', 'H' or 0 if not labelled.
+} trace_event_t;
+
+typedef struct {
+    keypos_t pos;
+    uint16_t keycode;
+    uint16_t press_time;
+    uint16_t settle_time;
+    char     expect;
+    char     result; // 'T', 'H' or 0 while unsettled.
+    bool     by_timeout;
+    bool     open;
+} decision_t;
+
+static trace_event_t events[MAX_EVENTS];
+static uint16_t      num_events = 0;
+static decision_t    decisions[MAX_DECISIONS];
+static uint16_t      num_decisions = 0;
+
+typedef struct {
+    uint8_t mods;
+    bool    keys[MATRIX_ROWS][MATRIX_COLS];
+} host_report_t;
+
+static uint16_t      keymap[MATRIX_ROWS][MATRIX_COLS];
+static host_report_t host_state;
+static host_report_t last_report;
+static uint16_t now        = 0;
+static uint32_t blocked_ms = 0;
+static uint32_t reports    = 0;
+static uint8_t  mods       = 0;
+static bool     in_task    = false;
+static bool     verbose    = false;
+
+// Stub QMK API.
+
+uint16_t timer_read(void) {
+    return now;
+}
+
+uint32_t timer_read32(void) {
+    return now;
+}
+
+void wait_ms(uint16_t ms) {
+    now += ms;
+    blocked_ms += ms;
+}
+
+uint8_t get_mods(void) {
+    return mods;
+}
+
+void add_mods(uint8_t m) {
+    mods |= m;
+}
+
+void del_mods(uint8_t m) {
+    mods &= ~m;
+}
+
+void send_keyboard_report(void) {
+    host_state.mods = mods;
+    if (memcmp(&host_state, &last_report, sizeof(host_report_t)) != 0) {
+        last_report = host_state;
+        ++reports;
+    }
+}
+
+static bool same_pos(keypos_t a, keypos_t b) {
+    return a.row == b.row && a.col == b.col;
+}
+
+static decision_t *open_decision(keypos_t pos) {
+    for (int i = num_decisions - 1; i >= 0; --i) {
+        if (decisions[i].open && same_pos(decisions[i].pos, pos)) {
+            return &decisions[i];
+        }
+    }
+    return NULL;
+}
+
+// Converts a 5-bit MOD_* code to the 8-bit mask used in reports.
+static uint8_t mod_bits(uint8_t mod5) {
+    return (mod5 & 0x10) ? (mod5 & 0x0F) << 4 : (mod5 & 0x0F);
+}
+
+void process_action(keyrecord_t *record, action_t action) {
+    const uint8_t m = mod_bits((action.code >> 8) & 0x1F);
+    if (record->event.pressed) {
+        add_mods(m);
+    } else {
+        del_mods(m);
+    }
+    send_keyboard_report();
+    if (verbose) {
+        printf("  %5u host mods %s 0x%02X\n", now, record->event.pressed ? "down" : "up  ", m);
+    }
+}
+
+// Everything that makes it past Achordion is considered sent to the host.
+static void emit(uint16_t keycode, keyrecord_t *record) {
+    const keypos_t pos = record->event.key;
+    if (IS_QK_MOD_TAP(keycode) && record->tap.count == 0) {
+        const uint8_t m = mod_bits(QK_MOD_TAP_GET_MODS(keycode));
+        if (record->event.pressed) {
+            add_mods(m);
+        } else {
+            del_mods(m);
+        }
+    } else if (!IS_QK_LAYER_TAP(keycode) || record->tap.count) {
+        host_state.keys[pos.row][pos.col] = record->event.pressed;
+    }
+    send_keyboard_report();
+    if (verbose) {
+        printf("  %5u host (%2u,%u) %s 0x%04X tap=%u\n", now, record->event.key.row, record->event.key.col, record->event.pressed ? "down" : "up  ", keycode, record->tap.count);
+    }
+
+    if (!record->event.pressed) {
+        return;
+    }
+    decision_t *d   = open_decision(record->event.key);
+    decision_t *end = d ? d : &decisions[num_decisions];
+    if (d && !d->result) {
+        d->result      = record->tap.count ? 'T' : 'H';
+        d->settle_time = now;
+        d->by_timeout  = in_task && d->result == 'H';
+    }
+    // A key pressed earlier that is still unsettled when a later press reaches
+    // the host was settled as held without plumbing an event (eager mods).
+    for (decision_t *e = decisions; e < end; ++e) {
+        if (e->open && !e->result) {
+            e->result      = 'H';
+            e->settle_time = now;
+        }
+    }
+}
+
+void process_record(keyrecord_t *record) {
+    const uint16_t keycode = record->keycode ? record->keycode : keymap[record->event.key.row][record->event.key.col];
+    if (!process_achordion(keycode, record)) {
+        return;
+    }
+    emit(keycode, record);
+}
+
+// Trace playback.
+
+static void deliver(const trace_event_t *e) {
+    keymap[e->pos.row][e->pos.col] = e->keycode;
+
+    keyrecord_t record = {
+        .event =
+            {
+                .key     = e->pos,
+                .time    = now, // Detection is delayed if the loop was blocked.
+                .type    = KEY_EVENT,
+                .pressed = e->pressed,
+            },
+        .tap = {.count = e->tap_count},
+    };
+
+    const bool is_tap_hold = IS_QK_MOD_TAP(e->keycode) || IS_QK_LAYER_TAP(e->keycode);
+    if (is_tap_hold && e->pressed && e->tap_count == 0 && num_decisions < MAX_DECISIONS) {
+        decisions[num_decisions++] = (decision_t){
+            .pos        = e->pos,
+            .keycode    = e->keycode,
+            .press_time = now,
+            .expect     = e->expect,
+            .open       = true,
+        };
+    }
+
+    process_record(&record);
+    // Events plumbed by Achordion go out on the scan that detected the event.
+    achordion_task();
+
+    if (!e->pressed) {
+        decision_t *d = open_decision(e->pos);
+        if (d) {
+            if (!d->result) { // Released without plumbing a press, e.g. eager mods.
+                d->result      = 'H';
+                d->settle_time = now;
+            }
+            d->open = false;
+        }
+    }
+}
+
+static bool parse_line(char *line, const char *path, int lineno) {
+    char *comment = strchr(line, '#');
+    if (comment) {
+        *comment = '\0';
+    }
+
+    char    *tok[7];
+    int      n    = 0;
+    char    *save = NULL;
+    for (char *t = strtok_r(line, " \t\r\n", &save); t && n < 7; t = strtok_r(NULL, " \t\r\n", &save)) {
+        tok[n++] = t;
+    }
+    if (n == 0) {
+        return true;
+    }
+    if (n < 5 || num_events >= MAX_EVENTS) {
+        fprintf(stderr, "%s:%d: expected <time> <row> <col> <keycode> <down|up>\n", path, lineno);
+        return false;
+    }
+
+    trace_event_t e = {
+        .time    = (uint16_t)strtol(tok[0], NULL, 0),
+        .pos     = {.row = (uint8_t)strtol(tok[1], NULL, 0), .col = (uint8_t)strtol(tok[2], NULL, 0)},
+        .keycode = (uint16_t)strtol(tok[3], NULL, 0),
+        .pressed = strcmp(tok[4], "down") == 0,
+    };
+    if (e.pos.row >= MATRIX_ROWS || e.pos.col >= MATRIX_COLS) {
+        fprintf(stderr, "%s:%d: key position out of range\n", path, lineno);
+        return false;
+    }
+    for (int i = 5; i < n; ++i) {
+        if (strncmp(tok[i], "tap=", 4) == 0) {
+            e.tap_count = (uint8_t)atoi(tok[i] + 4);
+        } else if (strcmp(tok[i], "expect=tap") == 0) {
+            e.expect = 'T';
+        } else if (strcmp(tok[i], "expect=hold") == 0) {
+            e.expect = 'H';
+        } else {
+            fprintf(stderr, "%s:%d: unknown field '%s'\n", path, lineno, tok[i]);
+            return false;
+        }
+    }
+    events[num_events++] = e;
+    return true;
+}
+
+static bool load_trace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    int  lineno = 0;
+    bool ok     = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        ok = parse_line(line, path, ++lineno);
+    }
+    fclose(f);
+    return ok;
+}
+
+// Replays the loaded trace and prints the per-decision report. Returns the
+// number of misclassified decisions.
+static int run(const char *path) {
+    uint16_t i   = 0;
+    uint16_t end = num_events ? events[num_events - 1].time + TAIL_MS : 0;
+    while (i < num_events || now <= end) {
+        // Anything Achordion settles before new events arrive is a timeout.
+        in_task = true;
+        timer_service_task();
+        achordion_task();
+        in_task = false;
+        while (i < num_events && events[i].time <= now) {
+            deliver(&events[i++]);
+        }
+        ++now;
+    }
+
+    printf("%s\n", path);
+    uint32_t total_latency = 0;
+    uint16_t max_latency = 0, settled = 0, timeouts = 0, labelled = 0, wrong = 0;
+    for (uint16_t k = 0; k < num_decisions; ++k) {
+        const decision_t *d       = &decisions[k];
+        const uint16_t    latency = d->settle_time - d->press_time;
+        const bool        miss    = d->expect && d->result && d->expect != d->result;
+        printf("  %5u (%2u,%u) 0x%04X -> %-7s %4u ms%s%s\n", d->press_time, d->pos.row, d->pos.col, d->keycode, d->result == 'T' ? "tap" : d->result == 'H' ? "hold" : "pending", d->result ? latency : 0, d->by_timeout ? " (timeout)" : "", miss ? "  MISCLASSIFIED" : "");
+        if (d->result) {
+            ++settled;
+            total_latency += latency;
+            if (latency > max_latency) {
+                max_latency = latency;
+            }
+        }
+        timeouts += d->by_timeout;
+        labelled += d->expect != 0;
+        wrong += miss;
+    }
+    printf("  decisions %u, settled by timeout %u\n", num_decisions, timeouts);
+    printf("  latency ms: mean %.1f, max %u\n", settled ? (double)total_latency / settled : 0.0, max_latency);
+    printf("  misclassified %u of %u labelled\n", wrong, labelled);
+    printf("  blocked in wait_ms %u ms, host reports %u\n\n", blocked_ms, reports);
+    return wrong;
+}
+
+int main(int argc, char **argv) {
+    int first = 1;
+    if (argc > 1 && strcmp(argv[1], "-v") == 0) {
+        verbose = true;
+        ++first;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "usage: %s [-v] trace...\n", argv[0]);
+        return 2;
+    }
+
+    int wrong = 0;
+    for (int a = first; a < argc; ++a) {
+        fflush(stdout);
+        const pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 2;
+        }
+        if (pid == 0) {
+            if (!load_trace(argv[a])) {
+                _exit(2);
+            }
+            const int n = run(argv[a]);
+            fflush(stdout);
+            _exit(n ? 1 : 0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) == 2) {
+            return 2;
+        }
+        wrong += WEXITSTATUS(status);
+    }
+    return wrong ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+# Copyright 2026 @aldld
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Generates a keymap's chord decision table from its chord_table.json.
+
+The table answers, for a tap-hold key and another key pressed while it is
+down, whether the pair is a chord (settle the tap-hold key as held) or a roll
+(settle it as tapped). It is built from the keymap's handedness, as in QMK's
+`chordal_hold_layout`, plus per-pair exceptions that the handedness model
+can't express.
+
+Spec format:
+
+    {
+        "layout": "LAYOUT_voyager",
+        "hands": [
+            "LLLLLL RRRRRR",
+            ...
+            "**  **"
+        ],
+        "exceptions": [
+            {"tap_hold": [4, 0], "other": "L", "chord": false},
+            {"tap_hold": [2, 0], "other": [[2, 1], [2, 2]], "chord": true}
+        ]
+    }
+
+`hands` lists the keys in the order of the layout macro's arguments, one
+string per visual row; whitespace is ignored. Each key is 'L' or 'R' for the
+hand that presses it, or '*' for keys that chord with anything (thumbs). A
+tap-hold key and another key chord if they are on opposite hands or either is
+'*'.
+
+Exceptions override the result for the pairs they list, in order. Keys are
+given as [row, index] into `hands`, counting only key characters. `other` is
+a list of keys, or 'L', 'R' or '*' for all keys with that handedness.
+
+Two files are written next to the spec: chord_table.h and chord_table.c. They
+are checked in, so that building the firmware doesn't need Python. Rerun this
+script after editing the spec:
+
+    tools/gen_chord_table.py keyboards/zsa/voyager/keymaps/aldld/chord_table.json
+"""
+
+import argparse
+import json
+import os
+import sys
+
+HEADER = """\
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_chord_table.py from {spec}. Do not edit.
+"""
+
+TABLE_H = """\
+#pragma once
+
+#include "quantum.h"
+
+/** Number of keys in the layout. */
+#define CHORD_TABLE_KEYS {num_keys}
+
+/**
+ * Returns true if pressing the key at `other_key` while the tap-hold key at
+ * `tap_hold_key` is down is a chord, that is, the tap-hold key should be
+ * settled as held. Positions outside the layout always chord.
+ */
+bool chord_table_is_chord(keypos_t tap_hold_key, keypos_t other_key);
+"""
+
+TABLE_C = """\
+#include QMK_KEYBOARD_H
+#include "chord_table.h"
+
+// clang-format off
+// Handedness of each key, for QMK's Chordal Hold.
+const char chordal_hold_layout[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
+    {layout}(
+{hands}
+    );
+
+// Position of each key in the layout plus one, or 0 for matrix positions that
+// are not in the layout.
+static const uint8_t chord_key_index[MATRIX_ROWS][MATRIX_COLS] PROGMEM =
+    {layout}(
+{indices}
+    );
+
+// Row i has bit j set if key j chords with tap-hold key i, in layout order.
+static const uint8_t chord_bits[CHORD_TABLE_KEYS][{row_bytes}] PROGMEM = {{
+{bits}
+}};
+// clang-format on
+
+bool chord_table_is_chord(keypos_t tap_hold_key, keypos_t other_key) {{
+    if (tap_hold_key.row >= MATRIX_ROWS || tap_hold_key.col >= MATRIX_COLS || other_key.row >= MATRIX_ROWS || other_key.col >= MATRIX_COLS) {{
+        return true;
+    }}
+    const uint8_t i = pgm_read_byte(&chord_key_index[tap_hold_key.row][tap_hold_key.col]);
+    const uint8_t j = pgm_read_byte(&chord_key_index[other_key.row][other_key.col]);
+    if (i == 0 || j == 0) {{
+        return true;
+    }}
+    return pgm_read_byte(&chord_bits[i - 1][(j - 1) / 8]) & (1 << ((j - 1) % 8));
+}}
+"""
+
+
+def fail(message):
+    sys.exit(f"gen_chord_table: {message}")
+
+
+def parse_hands(rows):
+    """Returns the handedness per key and the index of each key's first one
+    in each visual row."""
+    hands = []
+    row_starts = []
+    for row in rows:
+        row_starts.append(len(hands))
+        for c in row:
+            if c.isspace():
+                continue
+            if c not in "LR*":
+                fail(f"unknown handedness '{c}' in hands")
+            hands.append(c)
+    return hands, row_starts + [len(hands)]
+
+
+def key_index(pos, row_starts):
+    row, index = pos
+    if not 0 <= row < len(row_starts) - 1:
+        fail(f"no row {row} in hands")
+    start = row_starts[row]
+    if not 0 <= index < row_starts[row + 1] - start:
+        fail(f"no key {index} in row {row} of hands")
+    return start + index
+
+
+def build_chords(hands, row_starts, exceptions):
+    n = len(hands)
+    chords = [[hands[i] == "*" or hands[j] == "*" or hands[i] != hands[j] for j in range(n)] for i in range(n)]
+    for e in exceptions:
+        i = key_index(e["tap_hold"], row_starts)
+        other = e["other"]
+        if isinstance(other, str):
+            targets = [j for j in range(n) if hands[j] == other]
+        else:
+            targets = [key_index(pos, row_starts) for pos in other]
+        for j in targets:
+            chords[i][j] = bool(e["chord"])
+    return chords
+
+
+def layout_args(values, row_starts, width):
+    lines = []
+    for r in range(len(row_starts) - 1):
+        row = values[row_starts[r] : row_starts[r + 1]]
+        lines.append("        " + ", ".join(v.rjust(width) for v in row))
+    return ",\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("spec", help="path to a keymap's chord_table.json")
+    args = parser.parse_args()
+
+    with open(args.spec) as f:
+        spec = json.load(f)
+    hands, row_starts = parse_hands(spec["hands"])
+    if not 0 < len(hands) < 256:
+        fail("layouts need between 1 and 255 keys")
+    chords = build_chords(hands, row_starts, spec.get("exceptions", []))
+
+    row_bytes = (len(hands) + 7) // 8
+    bits = []
+    for i, row in enumerate(chords):
+        packed = [sum(1 << b for b in range(8) if 8 * k + b < len(row) and row[8 * k + b]) for k in range(row_bytes)]
+        bits.append("    {" + ", ".join(f"0x{v:02X}" for v in packed) + f"}}, // {i}")
+
+    out_dir = os.path.dirname(os.path.abspath(args.spec))
+    spec_path = os.path.relpath(os.path.abspath(args.spec), os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    header = HEADER.format(spec=spec_path)
+    with open(os.path.join(out_dir, "chord_table.h"), "w") as f:
+        f.write(header + "\n" + TABLE_H.format(num_keys=len(hands)))
+    with open(os.path.join(out_dir, "chord_table.c"), "w") as f:
+        f.write(
+            header
+            + "\n"
+            + TABLE_C.format(
+                layout=spec["layout"],
+                hands=layout_args([f"'{h}'" for h in hands], row_starts, 3),
+                indices=layout_args([str(i + 1) for i in range(len(hands))], row_starts, 2),
+                row_bytes=row_bytes,
+                bits="\n".join(bits),
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
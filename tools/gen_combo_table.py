@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+# Copyright 2026 @aldld
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Generates a keymap's combo index from the combos in its keymap.c or
+keymap_layers.h.
+
+The index maps each keycode used in a combo to the combos in `key_combos[]`
+that it is part of, one bit per combo, so that the firmware can tell with a
+single lookup whether a key can start or complete a combo. See
+users/aldld/combo_index.h.
+
+The combos are read from definitions of the usual form:
+
+    const uint16_t PROGMEM combo_fs[] = {KC_F, MT(MOD_LGUI, KC_S), COMBO_END};
+    combo_t key_combos[] = {
+        COMBO(combo_fs, KC_LBRC),
+        ...
+    };
+
+combo_table.h is written next to the input file and checked in. It defines
+`combo_table_lookup()` and must be included by keymap.c only, after the
+combos, since the keycodes may use the keymap's own layer names. Rerun this
+script after changing the combos. tools/gen_keymap.py runs it on the
+keymap_layers.h it generates:
+
+    tools/gen_combo_table.py keyboards/zsa/voyager/keymaps/aldld/keymap_layers.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MAX_COMBOS = 32
+
+HEADER = """\
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_combo_table.py from {source}. Do not edit.
+// Include from keymap.c only, after key_combos[].
+
+#pragma once
+
+// Combos, in key_combos[] order:
+{combo_list}
+#define COMBO_TABLE_COUNT {count}
+
+uint32_t combo_table_lookup(uint16_t keycode) {{
+    switch (keycode) {{
+{cases}
+        default:
+            return 0;
+    }}
+}}
+"""
+
+
+def fail(message):
+    sys.exit(f"gen_combo_table: {message}")
+
+
+def strip_comments(source):
+    source = re.sub(r"/\*.*?\*/", "", source, flags=re.S)
+    return re.sub(r"//[^\n]*", "", source)
+
+
+def split_args(text):
+    """Splits a comma-separated list, ignoring commas inside parentheses."""
+    args, depth, current = [], 0, ""
+    for c in text:
+        if c == "," and depth == 0:
+            args.append(current.strip())
+            current = ""
+            continue
+        depth += c == "("
+        depth -= c == ")"
+        current += c
+    if current.strip():
+        args.append(current.strip())
+    return args
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("keymap", help="path to the keymap.c or keymap_layers.h defining key_combos[]")
+    args = parser.parse_args()
+
+    with open(args.keymap) as f:
+        source = strip_comments(f.read())
+
+    keys = {}
+    for m in re.finditer(r"const\s+uint16_t\s+PROGMEM\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;", source, re.S):
+        members = split_args(m.group(2))
+        if not members or members[-1] != "COMBO_END":
+            fail(f"{m.group(1)} doesn't end with COMBO_END")
+        keys[m.group(1)] = members[:-1]
+
+    m = re.search(r"combo_t\s+key_combos\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;", source, re.S)
+    if not m:
+        fail("no key_combos[] found")
+    combos = [re.match(r"\w+\s*\(\s*(\w+)", c).group(1) for c in split_args(m.group(1))]
+    if len(combos) > MAX_COMBOS:
+        fail(f"at most {MAX_COMBOS} combos are supported")
+
+    masks = {}
+    for i, name in enumerate(combos):
+        if name not in keys:
+            fail(f"no key list for {name}")
+        for key in keys[name]:
+            masks[key] = masks.get(key, 0) | (1 << i)
+
+    keymap_dir = os.path.dirname(os.path.abspath(args.keymap))
+    repo_root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+    cases = "\n".join(f"        case {key}:\n            return 0x{mask:X};" for key, mask in masks.items())
+    with open(os.path.join(keymap_dir, "combo_table.h"), "w") as f:
+        f.write(
+            HEADER.format(
+                source=os.path.relpath(os.path.abspath(args.keymap), repo_root),
+                combo_list="\n".join(f"//   {i} {name}" for i, name in enumerate(combos)),
+                count=len(combos),
+                cases=cases,
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+# Copyright 2026 @aldld
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Generates every keyboard's keymap tables from users/aldld/layout.json.
+
+The layout spec is the one place where the layers of all keyboards are
+written down. Like a keymap.json, it lists layers of keycodes, but on a
+board-independent grid: four rows of twelve keys, the top row first, then a
+row of six thumb keys from left to right. Each build target in qmk.json that
+has an entry under `targets` gets its keymap from the grid:
+
+    {
+        "layer_names": ["_BASE", ...],
+        "custom_keycodes": ["MAC_LOCK", ...],
+        "layers": [[...54 keycodes...], ...],
+        "hands": ["LLLLLL RRRRRR", ..., "*** ***"],
+        "tapping_terms": {"MT(MOD_LSFT, KC_T)": 155, ...},
+        "targets": {
+            "zsa/voyager": {
+                "layout": "LAYOUT_voyager",
+                "rows": [0, 1, 2, 3],
+                "thumbs": [1, 2, 3, 4],
+                "overrides": {"_BASE": {"4,0": "QK_BOOT"}},
+                "chord_table": true,
+                "tapping_terms": true,
+                "combos": [{"name": "combo_fs", "keys": ["KC_F", "KC_S"], "result": "KC_LBRC"}]
+            }
+        }
+    }
+
+A target's layout macro takes the grid rows in `rows`, twelve keys each,
+then the thumb keys in `thumbs`. `overrides` replaces keys of a layer on that
+target, given as "row,column" on the grid, with row 4 for the thumbs.
+
+For each target, keymap_layers.h is written to its keymap directory, with the
+layer and custom keycode enums, the keymaps and the combos. keymap.c includes
+it, then combo_table.h if the target has combos. Depending on the target's
+flags, the script also writes:
+
+  - `chord_table`: the hands of the keymap's chord_table.json, then reruns
+    tools/gen_chord_table.py on it.
+  - `combos`: combo_table.h, by running tools/gen_combo_table.py.
+  - `tapping_terms`: a tapping term per matrix position in keymap_layers.h,
+    from `tapping_terms` and the keycodes on every layer, returned by
+    `keymap_tapping_term()`. Keys not listed get TAPPING_TERM.
+
+Finally, it prints the size of the generated tables for each target. All
+generated files are checked in. Rerun this script after editing the spec:
+
+    tools/gen_keymap.py
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+GRID_COLS = 12
+GRID_ROWS = 4
+THUMB_ROW = 4
+THUMBS = 6
+TOOLS_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_ROOT = os.path.dirname(TOOLS_DIR)
+
+HEADER = """\
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_keymap.py from {spec} for {target}. Do not edit.
+// Include from keymap.c only.
+
+#pragma once
+"""
+
+TERMS = """
+// Tapping term per matrix position, or 0 for TAPPING_TERM.
+static const uint16_t keymap_tapping_terms[MATRIX_ROWS][MATRIX_COLS] PROGMEM = {layout}(
+{terms}
+);
+
+uint16_t keymap_tapping_term(keypos_t key) {{
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {{
+        return TAPPING_TERM;
+    }}
+    const uint16_t term = pgm_read_word(&keymap_tapping_terms[key.row][key.col]);
+    return term != 0 ? term : TAPPING_TERM;
+}}
+"""
+
+
+def fail(message):
+    sys.exit(f"gen_keymap: {message}")
+
+
+def target_keys(target):
+    """Returns the grid position of each argument of the target's layout."""
+    keys = [(r, c) for r in target["rows"] for c in range(GRID_COLS)]
+    return keys + [(THUMB_ROW, t) for t in target["thumbs"]]
+
+
+def grid_layers(spec, name, target):
+    """Returns the target's layers as dicts from grid position to keycode."""
+    layers = []
+    for layer_name, keycodes in zip(spec["layer_names"], spec["layers"]):
+        if len(keycodes) != GRID_ROWS * GRID_COLS + THUMBS:
+            fail(f"layer {layer_name} needs {GRID_ROWS * GRID_COLS + THUMBS} keys")
+        layer = {(i // GRID_COLS, i % GRID_COLS) if i < GRID_ROWS * GRID_COLS else (THUMB_ROW, i - GRID_ROWS * GRID_COLS): k for i, k in enumerate(keycodes)}
+        for pos, keycode in target.get("overrides", {}).get(layer_name, {}).items():
+            row, col = (int(x) for x in pos.split(","))
+            if (row, col) not in layer:
+                fail(f"{name}: no key {pos} on the grid")
+            layer[(row, col)] = keycode
+        layers.append(layer)
+    return layers
+
+
+def layout_call(layout, values, target):
+    """Formats a layout macro call with one line per grid row."""
+    width = max(len(v) for v in values) + 1
+    cells = [v + "," for v in values[:-1]] + values[-1:]
+    lines = []
+    n = 0
+    for count in [GRID_COLS] * len(target["rows"]) + [len(target["thumbs"])]:
+        lines.append("  " + " ".join(c.ljust(width) for c in cells[n : n + count]).rstrip())
+        n += count
+    return f"{layout}(\n" + "\n".join(lines) + "\n)"
+
+
+def write_keymap_layers(spec, spec_path, name, target, out_dir):
+    keys = target_keys(target)
+    layers = grid_layers(spec, name, target)
+    custom = spec["custom_keycodes"]
+
+    out = [HEADER.format(spec=spec_path, target=name)]
+    out.append("enum layers {\n" + "".join(f"    {n},\n" for n in spec["layer_names"]) + "};\n")
+    out.append("enum custom_keycodes {\n" + f"    {custom[0]} = SAFE_RANGE,\n" + "".join(f"    {k},\n" for k in custom[1:]) + "};\n")
+
+    out.append("// clang-format off")
+    out.append("const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {")
+    calls = [f"[{n}] = " + layout_call(target["layout"], [layer[k] for k in keys], target) for n, layer in zip(spec["layer_names"], layers)]
+    out.append(",\n\n".join(calls))
+    out.append("};\n// clang-format on")
+
+    combos = [c for c in target.get("combos", []) if not c.get("disabled")]
+    if combos:
+        out.append("")
+        for c in combos:
+            out.append(f"const uint16_t PROGMEM {c['name']}[] = {{{', '.join(c['keys'])}, COMBO_END}};")
+        out.append("\ncombo_t key_combos[] = {")
+        out.extend(f"    COMBO({c['name']}, {c['result']})," for c in combos)
+        out.append("};")
+
+    if target.get("tapping_terms"):
+        terms = {}
+        for layer in layers:
+            for k in keys:
+                term = spec["tapping_terms"].get(layer[k])
+                if term is None:
+                    continue
+                if terms.get(k, term) != term:
+                    fail(f"{name}: key {k} has different tapping terms on different layers")
+                terms[k] = term
+        out.append(TERMS.format(layout=target["layout"], terms=layout_call("", [str(terms.get(k, 0)) for k in keys], target)[2:-2]))
+
+    with open(os.path.join(out_dir, "keymap_layers.h"), "w") as f:
+        f.write("\n".join(out) + "\n")
+    return layers, keys, combos
+
+
+def write_chord_table(spec, target, out_dir):
+    hands = "".join(c for row in spec["hands"] for c in row if not c.isspace())
+    if len(hands) != GRID_ROWS * GRID_COLS + THUMBS:
+        fail(f"hands needs {GRID_ROWS * GRID_COLS + THUMBS} keys")
+
+    def hand(pos):
+        row, col = pos
+        return hands[row * GRID_COLS + col] if row < THUMB_ROW else hands[GRID_ROWS * GRID_COLS + col]
+
+    path = os.path.join(out_dir, "chord_table.json")
+    with open(path) as f:
+        chord_spec = json.load(f)
+    rows = ["".join(hand((r, c)) for c in range(GRID_COLS)) for r in target["rows"]]
+    chord_spec["layout"] = target["layout"]
+    thumbs = "".join(hand((THUMB_ROW, t)) for t in target["thumbs"])
+    chord_spec["hands"] = [r[:6] + " " + r[6:] for r in rows] + [thumbs[: len(thumbs) // 2] + " " + thumbs[len(thumbs) // 2 :]]
+    with open(path, "w") as f:
+        json.dump(chord_spec, f, indent=4)
+        f.write("\n")
+    subprocess.run([sys.executable, os.path.join(TOOLS_DIR, "gen_chord_table.py"), path], check=True)
+
+
+def report(name, spec, target, keys, combos):
+    n = len(keys)
+    sizes = [("keymaps", len(spec["layers"]) * n * 2)]
+    if target.get("chord_table"):
+        sizes.append(("chord tables", n * 2 + n * ((n + 7) // 8)))
+    if combos:
+        sizes.append(("combo keys", sum(2 * (len(c["keys"]) + 1) for c in combos)))
+    if target.get("tapping_terms"):
+        sizes.append(("tapping terms", n * 2))
+    print(f"{name}: {n} keys, {len(spec['layers'])} layers")
+    for what, size in sizes:
+        print(f"  {what:<14} {size:>5} bytes flash")
+    if combos:
+        print(f"  {'key_combos':<14} {len(combos):>5} entries in RAM")
+    print(f"  {'total':<14} {sum(s for _, s in sizes):>5} bytes flash, counting layout keys only")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--spec", default=os.path.join(REPO_ROOT, "users", "aldld", "layout.json"), help="path to the layout spec")
+    args = parser.parse_args()
+
+    with open(args.spec) as f:
+        spec = json.load(f)
+    with open(os.path.join(REPO_ROOT, "qmk.json")) as f:
+        build_targets = json.load(f)["build_targets"]
+    spec_path = os.path.relpath(os.path.abspath(args.spec), REPO_ROOT)
+
+    for keyboard, keymap in build_targets:
+        target = spec["targets"].get(keyboard)
+        if target is None:
+            print(f"{keyboard}: not in {spec_path}, skipped")
+            continue
+        out_dir = os.path.join(REPO_ROOT, "keyboards", keyboard, "keymaps", keymap)
+        _, keys, combos = write_keymap_layers(spec, spec_path, keyboard, target, out_dir)
+        if target.get("chord_table"):
+            write_chord_table(spec, target, out_dir)
+        if combos:
+            subprocess.run([sys.executable, os.path.join(TOOLS_DIR, "gen_combo_table.py"), os.path.join(out_dir, "keymap_layers.h")], check=True)
+        report(keyboard, spec, target, keys, combos)
+
+
+if __name__ == "__main__":
+    main()
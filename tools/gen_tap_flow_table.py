@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# Copyright 2026 @aldld
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Generates a keymap's tap flow table from its tap_flow.json and a text corpus.
+
+Tap flow settles a tap-hold key as tapped when it is pressed soon after the
+previous key, so that fast typing never triggers a hold. The table gives a
+tap flow term per pair of previous key and tap-hold key, scaled from how
+common the pair is as a letter bigram in the corpus: common rolls such as
+"st" get the full term, while rare pairs get a short one or none, leaving
+their holds free.
+
+Spec format:
+
+    {
+        "keys": [
+            {"keycode": "MT(MOD_LGUI, KC_S)", "letter": "s"},
+            {"keycode": "MT(MOD_LSFT, KC_T)", "letter": "t", "shift": true},
+            ...
+        ],
+        "common": 0.005,
+        "rare": 0.0002,
+        "max_capitals": 0.05
+    }
+
+`keys` lists the tap-hold keys with tap flow and the letter each one types.
+A pair whose share of the corpus's bigrams is at least `common` gets the full
+term, one at most `rare` gets none, and those in between are scaled on a log
+scale. Previous keys that aren't letters form one class, counting every
+non-letter in the corpus.
+
+The keys marked `shift` hold Shift, and Shift is mostly held to capitalize a
+letter after a space or a period. For them, a pair gets no tap flow if more
+than `max_capitals` of the corpus's occurrences of it are capitalized.
+
+The terms are stored as 4-bit fractions of the tap flow term the firmware
+passes in, so that it can still be adjusted at run time. Two files are
+written next to the spec, tap_flow_table.h and tap_flow_table.c. They are
+checked in. Rerun this script after editing the spec or changing the corpus:
+
+    tools/gen_tap_flow_table.py keyboards/zsa/voyager/keymaps/aldld/tap_flow.json \\
+        /usr/share/common-licenses/* /usr/lib/python3.11/*.py
+"""
+
+import argparse
+import json
+import math
+import os
+import string
+import sys
+
+LEVELS = 15
+OTHER = 26  # Class of previous keys that aren't letters.
+
+HEADER = """\
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by tools/gen_tap_flow_table.py from {spec}
+// and a corpus of {num_files} files, {num_bigrams} bigrams. Do not edit.
+"""
+
+TABLE_H = """\
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * Returns the tap flow term for tap-hold key `keycode` pressed after
+ * `prev_keycode`, as a fraction of `max_term`, or 0 for keys not in the table.
+ */
+uint16_t tap_flow_table_term(uint16_t keycode, uint16_t prev_keycode, uint16_t max_term);
+"""
+
+TABLE_C = """\
+#include QMK_KEYBOARD_H
+#include "tap_flow_table.h"
+
+// clang-format off
+// Term per previous key class (a to z, then anything else) and tap-hold key,
+// in 1/{levels} of the tap flow term, two keys per byte, low nibble first.
+static const uint8_t tap_flow_levels[27][{row_bytes}] PROGMEM = {{
+{levels_rows}
+}};
+// clang-format on
+
+static int8_t key_column(uint16_t keycode) {{
+    switch (keycode) {{
+{cases}
+        default:
+            return -1;
+    }}
+}}
+
+static uint8_t prev_class(uint16_t keycode) {{
+    if (IS_QK_MOD_TAP(keycode)) {{
+        keycode = QK_MOD_TAP_GET_TAP_KEYCODE(keycode);
+    }} else if (IS_QK_LAYER_TAP(keycode)) {{
+        keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
+    }}
+    return KC_A <= keycode && keycode <= KC_Z ? keycode - KC_A : {other};
+}}
+
+uint16_t tap_flow_table_term(uint16_t keycode, uint16_t prev_keycode, uint16_t max_term) {{
+    const int8_t col = key_column(keycode);
+    if (col < 0) {{
+        return 0;
+    }}
+    const uint8_t levels = pgm_read_byte(&tap_flow_levels[prev_class(prev_keycode)][col / 2]);
+    const uint8_t level  = col % 2 ? levels >> 4 : levels & 0x0F;
+    return (uint32_t)max_term * level / {levels};
+}}
+"""
+
+
+def fail(message):
+    sys.exit(f"gen_tap_flow_table: {message}")
+
+
+def char_class(c):
+    return ord(c.lower()) - ord("a") if c in string.ascii_letters else OTHER
+
+
+def count_bigrams(paths):
+    """Returns counts of (previous class, letter, capitalized) triples."""
+    counts = {}
+    total = 0
+    for path in paths:
+        with open(path, errors="ignore") as f:
+            text = f.read()
+        for prev, c in zip(text, text[1:]):
+            if c not in string.ascii_letters:
+                continue
+            key = (char_class(prev), c.lower(), c.isupper())
+            counts[key] = counts.get(key, 0) + 1
+            total += 1
+    return counts, total
+
+
+def level(share, common, rare):
+    if share <= rare:
+        return 0
+    if share >= common:
+        return LEVELS
+    return max(1, round(LEVELS * math.log(share / rare) / math.log(common / rare)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("spec", help="path to a keymap's tap_flow.json")
+    parser.add_argument("corpus", nargs="+", help="text files to count bigrams in")
+    args = parser.parse_args()
+
+    with open(args.spec) as f:
+        spec = json.load(f)
+    keys = spec["keys"]
+    if not 0 < len(keys) < 128:
+        fail("between 1 and 127 keys are supported")
+    for key in keys:
+        if key["letter"] not in string.ascii_lowercase or len(key["letter"]) != 1:
+            fail(f"{key['keycode']} needs a lowercase letter")
+
+    counts, total = count_bigrams(args.corpus)
+    if total == 0:
+        fail("the corpus has no letters")
+
+    rows = []
+    for prev in range(27):
+        levels = []
+        for key in keys:
+            lower = counts.get((prev, key["letter"], False), 0)
+            upper = counts.get((prev, key["letter"], True), 0)
+            if key.get("shift") and upper > spec["max_capitals"] * (lower + upper):
+                levels.append(0)
+            else:
+                levels.append(level(lower / total, spec["common"], spec["rare"]))
+        levels += [0] * (len(levels) % 2)
+        packed = [levels[i] | levels[i + 1] << 4 for i in range(0, len(levels), 2)]
+        name = string.ascii_lowercase[prev] if prev < OTHER else "other"
+        rows.append("    {" + ", ".join(f"0x{v:02X}" for v in packed) + f"}}, // {name}")
+
+    cases = "\n".join(f"        case {key['keycode']}:\n            return {i};" for i, key in enumerate(keys))
+    out_dir = os.path.dirname(os.path.abspath(args.spec))
+    spec_path = os.path.relpath(os.path.abspath(args.spec), os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    header = HEADER.format(spec=spec_path, num_files=len(args.corpus), num_bigrams=total)
+    with open(os.path.join(out_dir, "tap_flow_table.h"), "w") as f:
+        f.write(header + "\n" + TABLE_H)
+    with open(os.path.join(out_dir, "tap_flow_table.c"), "w") as f:
+        f.write(
+            header
+            + "\n"
+            + TABLE_C.format(
+                levels=LEVELS,
+                row_bytes=(len(keys) + 1) // 2,
+                levels_rows="\n".join(rows),
+                cases=cases,
+                other=OTHER,
+            )
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,337 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file hid_tool.c
+ * @brief Reads diagnostics from the keyboard over raw HID (Linux hidraw).
+ *
+ * Usage:
+ *
+ *     hid_tool <device> trace          print the decision trace as a timeline
+ *     hid_tool <device> trace-clear    empty the decision trace
+ *     hid_tool <device> latency        print the latency histograms
+ *     hid_tool <device> latency-clear  reset the latency histograms
+ *     hid_tool <device> idle           print the key latency while idle and awake
+ *     hid_tool <device> motion         print the pointer report latency and jitter
+ *     hid_tool <device> motion-clear   reset the pointer report measurements
+ *
+ * `device` is the keyboard's raw HID interface, e.g. /dev/hidraw3. Of the
+ * keyboard's hidraw devices, it is the one whose report descriptor uses usage
+ * page 0xFF60. The firmware must be built with the matching feature, see
+ * users/aldld.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "achordion.h"
+#include "decision_trace.h"
+#include "hid_commands.h"
+#include "idle_mode.h"
+#include "latency_stats.h"
+#include "motion_coalesce.h"
+
+#define REPLY_TIMEOUT_MS 1000
+
+static int device = -1;
+
+// Sends `packet` and waits for the reply, which replaces it. Returns false on
+// errors, after printing them.
+static bool transact(uint8_t packet[HID_COMMAND_SIZE]) {
+    // hidraw expects the report ID first, 0 as raw HID has none.
+    uint8_t out[HID_COMMAND_SIZE + 1] = {0};
+    memcpy(&out[1], packet, HID_COMMAND_SIZE);
+    if (write(device, out, sizeof(out)) != sizeof(out)) {
+        perror("write");
+        return false;
+    }
+
+    const uint8_t command = packet[0];
+    struct pollfd pfd     = {.fd = device, .events = POLLIN};
+    for (;;) {
+        const int ready = poll(&pfd, 1, REPLY_TIMEOUT_MS);
+        if (ready <= 0) {
+            fprintf(stderr, "%s\n", ready == 0 ? "no reply from the keyboard" : strerror(errno));
+            return false;
+        }
+        const ssize_t n = read(device, packet, HID_COMMAND_SIZE);
+        if (n != HID_COMMAND_SIZE) {
+            fprintf(stderr, "read: %s\n", n < 0 ? strerror(errno) : "short reply");
+            return false;
+        }
+        if (packet[0] == HID_CMD_UNSUPPORTED) {
+            fprintf(stderr, "command 0x%02X is not supported by this firmware\n", command);
+            return false;
+        }
+        if (packet[0] == command) {
+            return true;
+        }
+        // Some other reply, e.g. to another tool. Keep waiting.
+    }
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return get_u16(p) | ((uint32_t)get_u16(&p[2]) << 16);
+}
+
+static const char *event_name(uint8_t event) {
+    switch (event) {
+        case TRACE_KEY_PRESS:
+            return "press";
+        case TRACE_KEY_RELEASE:
+            return "release";
+        case TRACE_COMBO:
+            return "combo";
+        case TRACE_TAP_FLOW:
+            return "tap flow";
+        case TRACE_ACHORDION_TRACK:
+            return "achordion track";
+        case TRACE_ACHORDION_HOLD:
+            return "achordion hold";
+        case TRACE_ACHORDION_TAP:
+            return "achordion tap";
+        case TRACE_EAGER_APPLY:
+            return "eager mods on";
+        case TRACE_EAGER_CLEAR:
+            return "eager mods off";
+        default:
+            return "?";
+    }
+}
+
+static const char *reason_name(uint8_t reason) {
+    static const char *const names[] = {
+        [ACHORDION_BY_CHORD]         = "chord",
+        [ACHORDION_BY_STREAK]        = "streak",
+        [ACHORDION_BY_ROLL]          = "roll",
+        [ACHORDION_BY_RELEASE_ORDER] = "release order",
+        [ACHORDION_BY_RELEASE]       = "release",
+        [ACHORDION_BY_TIMEOUT]       = "timeout",
+    };
+    return reason < sizeof(names) / sizeof(names[0]) && names[reason] ? names[reason] : "?";
+}
+
+static void print_record(const decision_trace_record_t *r, uint16_t first_time, uint16_t prev_time) {
+    printf("%7u %+6d  %-16s (%2u,%u)  0x%04X  ", (uint16_t)(r->time - first_time), (int16_t)(r->time - prev_time), event_name(r->event), r->row, r->col, r->keycode);
+    switch (r->event) {
+        case TRACE_KEY_PRESS:
+        case TRACE_KEY_RELEASE:
+            printf("tap=%u", r->arg);
+            break;
+        case TRACE_COMBO:
+            printf("%s", r->arg ? "down" : "up");
+            break;
+        case TRACE_TAP_FLOW:
+            printf("%s", r->arg ? "applies" : "off");
+            break;
+        case TRACE_ACHORDION_TRACK:
+            printf("%u tracked", r->arg);
+            break;
+        case TRACE_ACHORDION_HOLD:
+        case TRACE_ACHORDION_TAP:
+            printf("%s", reason_name(r->arg));
+            break;
+        case TRACE_EAGER_APPLY:
+        case TRACE_EAGER_CLEAR:
+            printf("mods 0x%02X", r->arg);
+            break;
+    }
+    putchar('\n');
+}
+
+static int cmd_trace(void) {
+    uint8_t  packet[HID_COMMAND_SIZE];
+    uint8_t  offset = 0, total = 0;
+    uint16_t first_time = 0, prev_time = 0, now = 0, dropped = 0;
+    do {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = HID_CMD_TRACE_READ;
+        packet[1] = offset;
+        if (!transact(packet)) {
+            return 1;
+        }
+        total              = packet[1];
+        const uint8_t n    = packet[3];
+        now                = get_u16(&packet[4]);
+        dropped            = get_u16(&packet[6]);
+        const uint8_t *rec = &packet[DECISION_TRACE_HEADER_SIZE];
+        if (offset == 0) {
+            printf("   time  delta  event            key     keycode detail\n");
+        }
+        for (uint8_t i = 0; i < n; ++i, rec += DECISION_TRACE_RECORD_SIZE) {
+            const decision_trace_record_t r = {
+                .time    = get_u16(&rec[0]),
+                .event   = rec[2],
+                .arg     = rec[3],
+                .keycode = get_u16(&rec[4]),
+                .row     = rec[6],
+                .col     = rec[7],
+            };
+            if (offset + i == 0) {
+                first_time = prev_time = r.time;
+            }
+            print_record(&r, first_time, prev_time);
+            prev_time = r.time;
+        }
+        if (n == 0) {
+            break;
+        }
+        offset += n;
+    } while (offset < total);
+
+    printf("%u records, last %u ms ago, %u dropped\n", total, total ? (uint16_t)(now - prev_time) : 0, dropped);
+    return 0;
+}
+
+static int cmd_trace_clear(void) {
+    uint8_t packet[HID_COMMAND_SIZE] = {HID_CMD_TRACE_CLEAR};
+    return transact(packet) ? 0 : 1;
+}
+
+// Upper bound in ms of latency histogram bucket `b`.
+static unsigned bucket_limit(uint8_t b) {
+    return b == 0 ? 0 : (1u << b) - 1;
+}
+
+// Returns the upper bound of the bucket holding the `pct` percentile.
+static unsigned percentile(const uint16_t *counts, uint8_t num_buckets, uint32_t total, unsigned pct) {
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < num_buckets; ++b) {
+        seen += counts[b];
+        if (seen * 100 >= total * pct) {
+            return bucket_limit(b);
+        }
+    }
+    return bucket_limit(num_buckets - 1);
+}
+
+static int cmd_latency(void) {
+    static const char *const path_names[LATENCY_NUM_PATHS] = {
+        [LATENCY_PATH_INSTANT]   = "instant",
+        [LATENCY_PATH_TAP_HOLD]  = "tap-hold",
+        [LATENCY_PATH_ACHORDION] = "achordion",
+        [LATENCY_PATH_TIMEOUT]   = "timeout",
+        [LATENCY_PATH_COMBO]     = "combo",
+    };
+
+    uint8_t packet[HID_COMMAND_SIZE];
+    uint8_t num_histograms = 1;
+    printf("%-10s %6s %5s %5s %5s %5s  buckets (ms upper bound: count)\n", "", "count", "p50", "p90", "p99", "max");
+    for (uint8_t h = 0; h < num_histograms; ++h) {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = HID_CMD_LATENCY_READ;
+        packet[1] = h;
+        if (!transact(packet)) {
+            return 1;
+        }
+        num_histograms            = packet[2];
+        const uint8_t num_buckets = packet[3];
+        if (num_buckets == 0 || LATENCY_STATS_HEADER_SIZE + 2 * num_buckets > HID_COMMAND_SIZE) {
+            fprintf(stderr, "bad reply for histogram %u\n", h);
+            return 1;
+        }
+        uint16_t counts[(HID_COMMAND_SIZE - LATENCY_STATS_HEADER_SIZE) / 2];
+        uint32_t total = 0;
+        for (uint8_t b = 0; b < num_buckets; ++b) {
+            counts[b] = get_u16(&packet[LATENCY_STATS_HEADER_SIZE + 2 * b]);
+            total += counts[b];
+        }
+
+        char name[16];
+        if (h < LATENCY_NUM_PATHS) {
+            snprintf(name, sizeof(name), "%s", path_names[h]);
+        } else {
+            snprintf(name, sizeof(name), "layer %u", h - LATENCY_NUM_PATHS);
+        }
+        if (total == 0) {
+            printf("%-10s %6u\n", name, 0);
+            continue;
+        }
+        printf("%-10s %6u %5u %5u %5u %5u ", name, total, percentile(counts, num_buckets, total, 50), percentile(counts, num_buckets, total, 90), percentile(counts, num_buckets, total, 99), get_u16(&packet[4]));
+        for (uint8_t b = 0; b < num_buckets; ++b) {
+            if (counts[b]) {
+                printf(" %u:%u", bucket_limit(b), counts[b]);
+            }
+        }
+        putchar('\n');
+    }
+    return 0;
+}
+
+static int cmd_latency_clear(void) {
+    uint8_t packet[HID_COMMAND_SIZE] = {HID_CMD_LATENCY_CLEAR};
+    return transact(packet) ? 0 : 1;
+}
+
+static int cmd_idle(void) {
+    uint8_t packet[HID_COMMAND_SIZE] = {HID_CMD_IDLE_READ};
+    if (!transact(packet)) {
+        return 1;
+    }
+    printf("%s, %u wake-ups\n", packet[1] ? "idle" : "awake", get_u16(&packet[2]));
+    printf("scan before a key to report, idle:  %u keys, average %u us, max %u us\n", get_u16(&packet[4]), get_u16(&packet[6]), get_u16(&packet[8]));
+    printf("scan before a key to report, awake: %u keys, average %u us, max %u us\n", get_u16(&packet[10]), get_u16(&packet[12]), get_u16(&packet[14]));
+    return 0;
+}
+
+static int cmd_motion(void) {
+    uint8_t packet[HID_COMMAND_SIZE] = {HID_CMD_MOTION_READ};
+    if (!transact(packet)) {
+        return 1;
+    }
+    const uint32_t reads   = get_u32(&packet[1]);
+    const uint32_t reports = get_u32(&packet[5]);
+    printf("%u sensor reads with motion in %u reports", reads, reports);
+    if (reports) {
+        printf(", %.2f reads per report", (double)reads / reports);
+    }
+    putchar('\n');
+    printf("first read to report: average %u us, max %u us\n", get_u16(&packet[9]), get_u16(&packet[11]));
+    printf("report interval jitter: average %u us, max %u us\n", get_u16(&packet[13]), get_u16(&packet[15]));
+    return 0;
+}
+
+static int cmd_motion_clear(void) {
+    uint8_t packet[HID_COMMAND_SIZE] = {HID_CMD_MOTION_CLEAR};
+    return transact(packet) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <device> trace|trace-clear|latency|latency-clear|idle|motion|motion-clear\n", argv[0]);
+        return 2;
+    }
+    device = open(argv[1], O_RDWR);
+    if (device < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    int status = 2;
+    if (strcmp(argv[2], "trace") == 0) {
+        status = cmd_trace();
+    } else if (strcmp(argv[2], "trace-clear") == 0) {
+        status = cmd_trace_clear();
+    } else if (strcmp(argv[2], "latency") == 0) {
+        status = cmd_latency();
+    } else if (strcmp(argv[2], "latency-clear") == 0) {
+        status = cmd_latency_clear();
+    } else if (strcmp(argv[2], "idle") == 0) {
+        status = cmd_idle();
+    } else if (strcmp(argv[2], "motion") == 0) {
+        status = cmd_motion();
+    } else if (strcmp(argv[2], "motion-clear") == 0) {
+        status = cmd_motion_clear();
+    } else {
+        fprintf(stderr, "unknown command '%s'\n", argv[2]);
+    }
+    close(device);
+    return status;
+}
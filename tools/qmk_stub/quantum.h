@@ -0,0 +1,218 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file quantum.h
+ * @brief Minimal host-side stand-in for the QMK API.
+ *
+ * Only the types, keycodes and functions used by the userspace features that
+ * are built on the host (see tools/) are declared here. Encodings follow QMK
+ * so that keycodes copied from a keymap or a recorded trace keep their values.
+ * The functions are implemented by the host tool that includes this header.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define MIN(x, y) ((x) < (y) ? (x) : (y))
+
+#ifndef MATRIX_ROWS
+#    define MATRIX_ROWS 12
+#endif
+#ifndef MATRIX_COLS
+#    define MATRIX_COLS 7
+#endif
+
+#ifndef TAP_CODE_DELAY
+#    define TAP_CODE_DELAY 0
+#endif
+
+// Key events.
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef enum {
+    TICK_EVENT  = 0,
+    KEY_EVENT   = 1,
+    COMBO_EVENT = 4,
+} keyevent_type_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    bool    interrupted : 1;
+    bool    reserved2 : 1;
+    bool    reserved1 : 1;
+    bool    reserved0 : 1;
+    uint8_t count : 4;
+} tap_t;
+
+typedef struct {
+    keyevent_t event;
+    tap_t      tap;
+    uint16_t   keycode;
+} keyrecord_t;
+
+#define IS_KEYEVENT(event) ((event).type == KEY_EVENT)
+#define IS_COMBOEVENT(event) ((event).type == COMBO_EVENT)
+
+// Keycodes.
+
+enum {
+    KC_NO    = 0x0000,
+    KC_A     = 0x0004,
+    KC_Z     = 0x001D,
+    KC_ENTER = 0x0028,
+    KC_BSPC  = 0x002A,
+    KC_SPACE = 0x002C,
+    KC_MINUS = 0x002D,
+    KC_QUOTE = 0x0034,
+    KC_COMMA = 0x0036,
+    KC_DOT   = 0x0037,
+    KC_LCTL  = 0x00E0,
+    KC_LSFT  = 0x00E1,
+    KC_LALT  = 0x00E2,
+    KC_LGUI  = 0x00E3,
+};
+
+#define QK_MOD_TAP 0x2000
+#define QK_MOD_TAP_MAX 0x3FFF
+#define QK_LAYER_TAP 0x4000
+#define QK_LAYER_TAP_MAX 0x4FFF
+
+#define MT(mod, kc) (QK_MOD_TAP | (((mod)&0x1F) << 8) | ((kc)&0xFF))
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer)&0xF) << 8) | ((kc)&0xFF))
+
+#define IS_QK_MOD_TAP(code) ((code) >= QK_MOD_TAP && (code) <= QK_MOD_TAP_MAX)
+#define IS_QK_LAYER_TAP(code) ((code) >= QK_LAYER_TAP && (code) <= QK_LAYER_TAP_MAX)
+#define QK_MOD_TAP_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MOD_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc)&0xFF)
+
+// Modifiers. MOD_* are the 5-bit codes used in keycodes, MOD_BIT() the 8-bit
+// mask used in reports.
+
+enum {
+    MOD_LCTL = 0x01,
+    MOD_LSFT = 0x02,
+    MOD_LALT = 0x04,
+    MOD_LGUI = 0x08,
+    MOD_RCTL = 0x11,
+    MOD_RSFT = 0x12,
+    MOD_RALT = 0x14,
+    MOD_RGUI = 0x18,
+};
+
+#define MOD_BIT(code) (1 << ((code)&0x07))
+#define MOD_BIT_LCTRL MOD_BIT(KC_LCTL)
+#define MOD_BIT_LSHIFT MOD_BIT(KC_LSFT)
+#define MOD_BIT_LALT MOD_BIT(KC_LALT)
+#define MOD_BIT_LGUI MOD_BIT(KC_LGUI)
+#define MOD_MASK_CTRL (MOD_BIT(KC_LCTL) | (MOD_BIT(KC_LCTL) << 4))
+#define MOD_MASK_SHIFT (MOD_BIT(KC_LSFT) | (MOD_BIT(KC_LSFT) << 4))
+#define MOD_MASK_ALT (MOD_BIT(KC_LALT) | (MOD_BIT(KC_LALT) << 4))
+#define MOD_MASK_GUI (MOD_BIT(KC_LGUI) | (MOD_BIT(KC_LGUI) << 4))
+#define MOD_MASK_CG (MOD_MASK_CTRL | MOD_MASK_GUI)
+
+#define mod_config(mod) (mod)
+
+uint8_t get_mods(void);
+void    add_mods(uint8_t mods);
+void    del_mods(uint8_t mods);
+
+// Actions. Only the mods and mods-tap kinds are needed.
+
+typedef union {
+    uint16_t code;
+} action_t;
+
+enum {
+    ACT_MODS     = 0x0,
+    ACT_MODS_TAP = 0x2,
+};
+
+#define ACTION(kind, param) ((kind) << 12 | (param))
+#define ACTION_MODS_KEY(mods, key) ACTION(ACT_MODS, (((mods)&0x1F) << 8) | (key))
+#define ACTION_MODS(mods) ACTION_MODS_KEY(mods, 0)
+#define ACTION_MODS_TAP_KEY(mods, key) ACTION(ACT_MODS_TAP, (((mods)&0x1F) << 8) | (key))
+
+void process_record(keyrecord_t *record);
+void process_action(keyrecord_t *record, action_t action);
+void send_keyboard_report(void);
+
+// Layers.
+
+typedef uint32_t layer_state_t;
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+uint8_t get_highest_layer(layer_state_t state);
+
+// Pointing devices, with 16-bit motion with MOUSE_EXTENDED_REPORT, else 8-bit.
+
+#ifdef MOUSE_EXTENDED_REPORT
+typedef int16_t mouse_xy_report_t;
+#    define XY_REPORT_MIN INT16_MIN
+#    define XY_REPORT_MAX INT16_MAX
+#else
+typedef int8_t mouse_xy_report_t;
+#    define XY_REPORT_MIN INT8_MIN
+#    define XY_REPORT_MAX INT8_MAX
+#endif
+typedef int8_t mouse_hv_report_t;
+
+#define HV_REPORT_MIN INT8_MIN
+#define HV_REPORT_MAX INT8_MAX
+
+typedef struct {
+    uint8_t           buttons;
+    mouse_xy_report_t x;
+    mouse_xy_report_t y;
+    mouse_hv_report_t v;
+    mouse_hv_report_t h;
+} report_mouse_t;
+
+// Timers.
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+void     wait_ms(uint16_t ms);
+
+#define timer_expired(current, future) ((uint16_t)((current) - (future)) < 0x8000)
+#define timer_elapsed(last) ((uint16_t)(timer_read() - (last)))
+
+// Debug output is compiled out, as with CONSOLE_ENABLE = no.
+
+#define dprintf(...) \
+    do {             \
+    } while (0)
+#define dprintln(s) \
+    do {            \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
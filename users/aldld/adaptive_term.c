@@ -0,0 +1,157 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "adaptive_term.h"
+#include "timer_service.h"
+#include <stdlib.h>
+
+// Averages are kept in 1/16 ms. Each new tap weighs 1/n, where n is the
+// number of taps so far up to ADAPTIVE_TERM_WINDOW, so that the first taps
+// give a plain average and later ones a moving average.
+#define ADAPTIVE_TERM_SCALE 16
+#define ADAPTIVE_TERM_WINDOW 16
+
+typedef struct {
+    uint16_t mean;
+    uint16_t deviation;
+    uint8_t  samples; // Saturates at 255.
+} __attribute__((packed)) key_stats_t;
+
+// Saved in the EEPROM user datablock. `keys_hash` identifies the key list the
+// stats are for, so that they are dropped when the list changes.
+typedef struct {
+    uint16_t    keys_hash;
+    key_stats_t keys[ADAPTIVE_TERM_MAX_KEYS];
+} __attribute__((packed)) saved_stats_t;
+
+_Static_assert(ADAPTIVE_TERM_MAX_KEYS <= 16, "ADAPTIVE_TERM_MAX_KEYS must be at most 16");
+_Static_assert(sizeof(saved_stats_t) <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE is too small for the adaptive terms");
+
+static saved_stats_t stats;
+// Learned terms in ms, 0 until a key has enough taps, and the terms as of the
+// last save.
+static uint16_t terms[ADAPTIVE_TERM_MAX_KEYS];
+static uint16_t saved_terms[ADAPTIVE_TERM_MAX_KEYS];
+// Press times of the keys, and the number of key presses seen at that time.
+static uint16_t press_time[ADAPTIVE_TERM_MAX_KEYS];
+static uint8_t  press_count[ADAPTIVE_TERM_MAX_KEYS];
+static uint16_t keys_down   = 0;
+static uint8_t  num_presses = 0;
+
+// Keymaps without adaptive terms get an empty list.
+__attribute__((weak)) const uint16_t adaptive_term_keys[] = {KC_NO};
+__attribute__((weak)) const uint8_t  adaptive_term_num_keys = 0;
+
+static int8_t key_index(uint16_t keycode) {
+    for (uint8_t i = 0; i < adaptive_term_num_keys; ++i) {
+        if (pgm_read_word(&adaptive_term_keys[i]) == keycode) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint16_t hash_keys(void) {
+    uint16_t hash = adaptive_term_num_keys;
+    for (uint8_t i = 0; i < adaptive_term_num_keys; ++i) {
+        hash = (hash << 5 | hash >> 11) ^ pgm_read_word(&adaptive_term_keys[i]);
+    }
+    return hash;
+}
+
+static uint16_t learned_term(const key_stats_t *key) {
+    if (key->samples < ADAPTIVE_TERM_MIN_SAMPLES) {
+        return 0;
+    }
+    const uint32_t term = (key->mean + (uint32_t)ADAPTIVE_TERM_DEVIATIONS * key->deviation) / ADAPTIVE_TERM_SCALE;
+    if (term < ADAPTIVE_TERM_MIN) {
+        return ADAPTIVE_TERM_MIN;
+    }
+    return term > ADAPTIVE_TERM_MAX ? ADAPTIVE_TERM_MAX : term;
+}
+
+static void add_tap(uint8_t i, uint16_t duration) {
+    key_stats_t  *key = &stats.keys[i];
+    const int16_t x   = MIN(duration, ADAPTIVE_TERM_MAX) * ADAPTIVE_TERM_SCALE;
+    if (key->samples == 0) {
+        key->mean      = x;
+        key->deviation = 0;
+    } else {
+        const int16_t n     = MIN(key->samples + 1, ADAPTIVE_TERM_WINDOW);
+        const int16_t error = abs(x - (int16_t)key->mean);
+        key->mean += (x - (int16_t)key->mean) / n;
+        key->deviation += (error - (int16_t)key->deviation) / n;
+    }
+    if (key->samples < UINT8_MAX) {
+        ++key->samples;
+    }
+    terms[i] = learned_term(key);
+}
+
+// Saves the stats if some term moved enough since the last save.
+static uint32_t save_if_changed(uint32_t deadline, void *arg) {
+    for (uint8_t i = 0; i < adaptive_term_num_keys; ++i) {
+        if (abs((int16_t)terms[i] - (int16_t)saved_terms[i]) >= ADAPTIVE_TERM_SAVE_THRESHOLD) {
+            eeconfig_update_user_datablock(&stats, 0, sizeof(stats));
+            memcpy(saved_terms, terms, sizeof(terms));
+            break;
+        }
+    }
+    return ADAPTIVE_TERM_SAVE_INTERVAL;
+}
+
+void adaptive_term_init(void) {
+    eeconfig_read_user_datablock(&stats, 0, sizeof(stats));
+    if (stats.keys_hash != hash_keys()) {
+        memset(&stats, 0, sizeof(stats));
+        stats.keys_hash = hash_keys();
+    }
+    for (uint8_t i = 0; i < adaptive_term_num_keys; ++i) {
+        terms[i] = saved_terms[i] = learned_term(&stats.keys[i]);
+    }
+    timer_service_start(ADAPTIVE_TERM_SAVE_INTERVAL, save_if_changed, NULL);
+}
+
+void adaptive_term_record(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_KEYEVENT(record->event)) {
+        return;
+    }
+    if (record->event.pressed) {
+        ++num_presses;
+    }
+    const int8_t i = key_index(keycode);
+    if (i < 0) {
+        return;
+    }
+    if (record->event.pressed) {
+        press_time[i]  = record->event.time;
+        press_count[i] = num_presses;
+        keys_down |= 1 << i;
+        return;
+    }
+    if (!(keys_down & (1 << i))) {
+        return;
+    }
+    keys_down &= ~(1 << i);
+
+    const uint16_t duration = TIMER_DIFF_16(record->event.time, press_time[i]);
+    // A hold with no other key pressed was most likely a tap that was too
+    // slow for the current term.
+    const bool held_alone = press_count[i] == num_presses && duration < ADAPTIVE_TERM_MAX;
+    if (record->tap.count > 0 || held_alone) {
+        add_tap(i, duration);
+    }
+}
+
+uint16_t adaptive_term_get(uint16_t keycode, uint16_t term) {
+    const int8_t i = key_index(keycode);
+    return i >= 0 && terms[i] != 0 ? terms[i] : term;
+}
+
+void adaptive_term_reset(void) {
+    memset(&stats, 0, sizeof(stats));
+    stats.keys_hash = hash_keys();
+    memset(terms, 0, sizeof(terms));
+    memset(saved_terms, 0, sizeof(saved_terms));
+    eeconfig_update_user_datablock(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file adaptive_term.h
+ * @brief Tapping terms learned from how long each tap-hold key is tapped.
+ *
+ * For each listed tap-hold key, keeps a moving average of how long the key is
+ * held down when it is tapped, and of how far taps stray from that average.
+ * Once a key has been tapped ADAPTIVE_TERM_MIN_SAMPLES times, its tapping
+ * term is the average plus ADAPTIVE_TERM_DEVIATIONS times the deviation,
+ * kept between ADAPTIVE_TERM_MIN and ADAPTIVE_TERM_MAX.
+ *
+ * Only taps are seen as taps, so a tap that is too slow for the current term
+ * would never pull the term up. A key that is held and released without any
+ * other key pressed meanwhile, and in under ADAPTIVE_TERM_MAX ms, is therefore
+ * also counted as a tap.
+ *
+ * The averages are saved to the EEPROM user datablock at most once every
+ * ADAPTIVE_TERM_SAVE_INTERVAL ms, and only when some term moved by
+ * ADAPTIVE_TERM_SAVE_THRESHOLD ms or more since the last save. Only changed
+ * bytes are written, and on the Voyager the EEPROM is emulated in flash by
+ * QMK's wear-leveling driver.
+ *
+ * Enable in rules.mk with:
+ *
+ *     ADAPTIVE_TERM_ENABLE = yes
+ *
+ * define EECONFIG_USER_DATA_SIZE in config.h, list the keys with
+ * `ADAPTIVE_TERM_KEYS()` in keymap.c, and call
+ *
+ *   - `adaptive_term_init()` from `keyboard_post_init_user()`,
+ *   - `adaptive_term_record()` at the top of `process_record_user()`,
+ *   - `adaptive_term_get()` in `get_tapping_term()`,
+ *   - `timer_service_task()` from `housekeeping_task_user()`, for the saves.
+ *
+ * When disabled, `adaptive_term_get()` returns the term it is given and the
+ * other functions compile to nothing.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef ADAPTIVE_TERM_MIN
+#    define ADAPTIVE_TERM_MIN 120
+#endif
+#ifndef ADAPTIVE_TERM_MAX
+#    define ADAPTIVE_TERM_MAX TAPPING_TERM
+#endif
+#ifndef ADAPTIVE_TERM_DEVIATIONS
+#    define ADAPTIVE_TERM_DEVIATIONS 4
+#endif
+#ifndef ADAPTIVE_TERM_MIN_SAMPLES
+#    define ADAPTIVE_TERM_MIN_SAMPLES 16
+#endif
+#ifndef ADAPTIVE_TERM_SAVE_INTERVAL
+#    define ADAPTIVE_TERM_SAVE_INTERVAL 1800000 // 30 minutes.
+#endif
+#ifndef ADAPTIVE_TERM_SAVE_THRESHOLD
+#    define ADAPTIVE_TERM_SAVE_THRESHOLD 5
+#endif
+#ifndef ADAPTIVE_TERM_MAX_KEYS
+#    define ADAPTIVE_TERM_MAX_KEYS 16
+#endif
+
+/** Defines the keymap's list of tap-hold keys whose terms are learned. */
+#define ADAPTIVE_TERM_KEYS(...)                                                       \
+    const uint16_t PROGMEM adaptive_term_keys[]    = {__VA_ARGS__};                   \
+    const uint8_t          adaptive_term_num_keys = ARRAY_SIZE(adaptive_term_keys); \
+    _Static_assert(ARRAY_SIZE(adaptive_term_keys) <= ADAPTIVE_TERM_MAX_KEYS, "Too many adaptive term keys")
+
+extern const uint16_t adaptive_term_keys[];
+extern const uint8_t  adaptive_term_num_keys;
+
+#ifdef ADAPTIVE_TERM_ENABLE
+/** Loads the saved averages. Call from `keyboard_post_init_user()`. */
+void adaptive_term_init(void);
+
+/** Notes a key event. Call from `process_record_user()`. */
+void adaptive_term_record(uint16_t keycode, keyrecord_t *record);
+
+/**
+ * Returns the learned tapping term for `keycode`, or `term` if the key isn't
+ * listed or hasn't been tapped often enough yet.
+ */
+uint16_t adaptive_term_get(uint16_t keycode, uint16_t term);
+
+/** Forgets everything learned, including the saved averages. */
+void adaptive_term_reset(void);
+#else
+#    define adaptive_term_init()
+#    define adaptive_term_record(keycode, record)
+#    define adaptive_term_get(keycode, term) (term)
+#endif
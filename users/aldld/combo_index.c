@@ -0,0 +1,122 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "combo_index.h"
+
+// Matrix positions of the combo keys that are held down.
+static uint8_t combo_keys_down[(MATRIX_ROWS * MATRIX_COLS + 7) / 8];
+static uint8_t num_combo_keys_down = 0;
+// Set once the combo engine has seen a non-combo key with no combo key down,
+// and so has flushed its buffer and reset every combo.
+static bool engine_idle = false;
+// Set while the current event skips combo matching.
+static bool skip_combos = false;
+// Combos that every combo key pressed since the engine last flushed its
+// buffer is part of, and the number of those keys.
+static uint32_t candidates     = 0;
+static uint8_t  num_candidates = 0;
+// Set once a combo has all its keys pressed, until the engine flushes its
+// buffer. The engine applies the combo when it flushes, so flushing early
+// through combo_disable(), which empties the buffer, would lose it.
+static bool combo_complete = false;
+
+// Sets or clears the bit for `key`, returning its previous value.
+static bool update_key_down(keypos_t key, bool down) {
+    const uint16_t i   = key.row * MATRIX_COLS + key.col;
+    const uint8_t  bit = 1 << (i % 8);
+    const bool     was = combo_keys_down[i / 8] & bit;
+    if (down) {
+        combo_keys_down[i / 8] |= bit;
+    } else {
+        combo_keys_down[i / 8] &= ~bit;
+    }
+    return was;
+}
+
+// Returns true if one of `combos` has `num_keys` keys.
+static bool has_combo_of_size(uint32_t combos, uint8_t num_keys) {
+    for (uint8_t i = 0; combos != 0; ++i, combos >>= 1) {
+        if (combos & 1) {
+            const uint16_t *keys = combo_get(i)->keys;
+            uint8_t         size = 0;
+            while (pgm_read_word(&keys[size]) != COMBO_END) {
+                ++size;
+            }
+            if (size == num_keys) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Narrows the candidate combos to those containing a newly pressed combo key.
+// If none is left, the keys waiting in the combo buffer can't be part of a
+// combo anymore, so they are flushed right away instead of when the combo
+// term runs out, and the new key starts over. That is unless a combo was
+// completed, e.g. F+S then T: the engine is left to apply it.
+static void update_candidates(uint32_t combos) {
+    if ((candidates & combos) != 0) {
+        candidates &= combos;
+        ++num_candidates;
+    } else {
+        if (candidates != 0 && !combo_complete && is_combo_enabled()) {
+            // Disabling combos flushes the buffer and resets every combo that
+            // isn't active.
+            combo_disable();
+            combo_enable();
+        }
+        candidates     = combos;
+        num_candidates = 1;
+    }
+    // Every candidate contains all the keys pressed since the last flush, so
+    // those of that size are complete.
+    if (has_combo_of_size(candidates, num_candidates)) {
+        combo_complete = true;
+    }
+}
+
+// Called when the engine flushes its buffer by itself.
+static void reset_candidates(void) {
+    candidates     = 0;
+    combo_complete = false;
+}
+
+void combo_index_pre_process(uint16_t keycode, keyrecord_t *record) {
+    skip_combos = false;
+    if (!IS_KEYEVENT(record->event) || record->event.key.row >= MATRIX_ROWS || record->event.key.col >= MATRIX_COLS) {
+        engine_idle = false;
+        reset_candidates();
+        return;
+    }
+
+    // Releases are matched to presses by position, since the keycode under
+    // a key may change while it is held.
+    if (record->event.pressed) {
+        const uint32_t combos = combo_table_lookup(keycode);
+        if (combos != 0) {
+            if (!update_key_down(record->event.key, true)) {
+                ++num_combo_keys_down;
+            }
+            engine_idle = false;
+            update_candidates(combos);
+            return;
+        }
+    } else if (update_key_down(record->event.key, false)) {
+        --num_combo_keys_down;
+        engine_idle = false;
+        reset_candidates(); // The engine flushes its buffer on release.
+        return;
+    }
+
+    reset_candidates(); // The engine flushes its buffer on a non-combo key.
+
+    if (num_combo_keys_down == 0) {
+        skip_combos = engine_idle;
+        engine_idle = true;
+    }
+}
+
+uint16_t combo_count(void) {
+    return skip_combos ? 0 : combo_count_raw();
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file combo_index.h
+ * @brief Keeps keys that are in no combo out of QMK's combo matching.
+ *
+ * QMK checks every key event against every combo in `key_combos[]`, looking
+ * for the keycode in each combo's key list. The combo index is a lookup from
+ * keycode to the combos it is part of, generated at build time from the
+ * keymap's combos by tools/gen_combo_table.py. When a key in no combo is
+ * pressed or released while the combo engine is idle, i.e. no combo key is
+ * held and the engine has already reset after the last one, combo matching
+ * is skipped for the event by reporting zero combos from `combo_count()`.
+ *
+ * The first such event after a combo key still goes through the engine, so
+ * that it flushes its buffer and resets the combos' state as usual.
+ *
+ * The index also resolves combos early. QMK holds a combo key in its buffer
+ * until the combo completes, the key is released, a key in no combo is
+ * pressed, or the combo term runs out. So typing a key of one combo followed
+ * by a key of another, e.g. S then T, waits out the whole term. Here the
+ * combos each pressed key is part of are intersected, and as soon as no
+ * combo is left the buffered keys are flushed without waiting. A combo that
+ * is complete is left for the engine to apply: F+S then T, from combo_fs then
+ * combo_pt, still types "[t" after the term, not "fst". Only the next combo
+ * key release, or key in no combo, lets the index flush early again.
+ *
+ * Enable in rules.mk with:
+ *
+ *     COMBO_INDEX_ENABLE = yes
+ *
+ * include the generated combo_table.h in keymap.c after `key_combos[]`, and
+ * call `combo_index_pre_process()` from `pre_process_record_user()`.
+ *
+ * When disabled, `combo_index_pre_process()` compiles to nothing.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * Returns the combos `keycode` is part of, bit i standing for
+ * `key_combos[i]`. Defined by the generated combo_table.h.
+ */
+uint32_t combo_table_lookup(uint16_t keycode);
+
+#ifdef COMBO_INDEX_ENABLE
+/** Looks up a key event before the combo engine sees it. */
+void combo_index_pre_process(uint16_t keycode, keyrecord_t *record);
+#else
+#    define combo_index_pre_process(keycode, record)
+#endif
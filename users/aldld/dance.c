@@ -0,0 +1,168 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "dance.h"
+#include "timer_service.h"
+
+// The dance in progress, not fired yet. `keycode` is KC_NO when there is none.
+static uint16_t      keycode = KC_NO;
+static dance_t       dance;
+static uint8_t       count   = 0;
+static bool          pressed = false;
+static timer_token_t token   = TIMER_SERVICE_INVALID_TOKEN;
+
+// Outcomes fired while their key was held, released with the key.
+static struct {
+    uint16_t       keycode;
+    dance_action_t action;
+} held[DANCE_MAX_HELD];
+static uint8_t num_held = 0;
+
+// Keymaps without dances get an empty table.
+__attribute__((weak)) const dance_t dance_table[]    = {{.term = 0}};
+__attribute__((weak)) const uint8_t dance_table_size = 0;
+
+static bool exists(const dance_action_t *action) {
+    return action->fn != NULL || action->keycode != KC_NO;
+}
+
+static void press(const dance_action_t *action) {
+    if (action->fn != NULL) {
+        action->fn(true);
+    } else {
+        register_code16(action->keycode);
+    }
+}
+
+static void release(const dance_action_t *action) {
+    if (action->fn != NULL) {
+        action->fn(false);
+    } else {
+        unregister_code16(action->keycode);
+    }
+}
+
+// Outcome of the taps so far, or NULL if there is none.
+static const dance_action_t *tap_action(void) {
+    return count <= DANCE_MAX_TAPS && exists(&dance.tap[count - 1]) ? &dance.tap[count - 1] : NULL;
+}
+
+static bool has_more_taps(void) {
+    for (uint8_t i = count; i < DANCE_MAX_TAPS; ++i) {
+        if (exists(&dance.tap[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool has_hold(void) {
+    return count == 1 && exists(&dance.hold);
+}
+
+// Fires `action`, held until the key is released if it still is, and ends
+// the dance.
+static void fire(const dance_action_t *action) {
+    timer_service_cancel(token);
+    token = TIMER_SERVICE_INVALID_TOKEN;
+    if (action != NULL) {
+        press(action);
+        if (!pressed) {
+            release(action);
+        } else if (num_held < DANCE_MAX_HELD) {
+            held[num_held].keycode  = keycode;
+            held[num_held++].action = *action;
+        } else {
+            // Nowhere to remember it, so the key can't hold it down.
+            release(action);
+        }
+    }
+    keycode = KC_NO;
+}
+
+static uint32_t term_expired(uint32_t deadline, void *arg) {
+    token = TIMER_SERVICE_INVALID_TOKEN;
+    fire(pressed && has_hold() ? &dance.hold : tap_action());
+    return 0;
+}
+
+static void restart_term(void) {
+    timer_service_cancel(token);
+    token = timer_service_start(dance.term ? dance.term : TAPPING_TERM, term_expired, NULL);
+    if (token == TIMER_SERVICE_INVALID_TOKEN) {
+        // No timer left to wait with: decide now, as a tap.
+        fire(tap_action());
+    }
+}
+
+static void on_press(uint16_t new_keycode) {
+    if (keycode != new_keycode) {
+        keycode = new_keycode;
+        count   = 0;
+        memcpy_P(&dance, &dance_table[keycode - SAFE_RANGE], sizeof(dance));
+    }
+    ++count;
+    pressed = true;
+    if (has_more_taps()) {
+        restart_term();
+    } else if (has_hold()) {
+        if (tap_action() == NULL) {
+            fire(&dance.hold);
+        } else {
+            restart_term();
+        }
+    } else {
+        fire(tap_action());
+    }
+}
+
+static void on_release(void) {
+    pressed = false;
+    if (has_more_taps()) {
+        restart_term();
+    } else {
+        fire(tap_action());
+    }
+}
+
+// Releases the outcome that `released` holds down, if any.
+static void release_held(uint16_t released) {
+    for (uint8_t i = 0; i < num_held; ++i) {
+        if (held[i].keycode == released) {
+            const dance_action_t action = held[i].action;
+            held[i]                     = held[--num_held];
+            release(&action);
+            return;
+        }
+    }
+}
+
+bool dance_can_hold(uint16_t dance_keycode) {
+    return keycode == dance_keycode && pressed && has_hold();
+}
+
+void dance_hold(void) {
+    if (keycode != KC_NO && pressed && has_hold()) {
+        fire(&dance.hold);
+    }
+}
+
+bool process_dance(uint16_t new_keycode, keyrecord_t *record) {
+    const bool is_dance = new_keycode >= SAFE_RANGE && new_keycode - SAFE_RANGE < dance_table_size;
+    if (record->event.pressed) {
+        if (keycode != KC_NO && keycode != new_keycode) {
+            // Interrupted.
+            fire(tap_action());
+        }
+        if (is_dance) {
+            on_press(new_keycode);
+        }
+    } else if (is_dance) {
+        if (keycode == new_keycode) {
+            on_release();
+        } else {
+            release_held(new_keycode);
+        }
+    }
+    return !is_dance;
+}
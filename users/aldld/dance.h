@@ -0,0 +1,103 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file dance.h
+ * @brief Table-driven tap dances that fire as soon as the outcome is known.
+ *
+ * QMK's tap dances wait out the tapping term after every tap, in case
+ * another one follows, even for dances that do nothing on a second tap. Here
+ * each dance lists the outcomes it has, a single, double and triple tap and a
+ * hold of the first press, and fires one as soon as it is the only outcome
+ * left:
+ *
+ * - on a press, if the dance has nothing for more taps nor a hold, e.g. the
+ *   first press of a dance with only a single tap;
+ * - on a release, if the dance has nothing for more taps, e.g. the first
+ *   release of a dance with a single tap and a hold;
+ * - when another key is pressed, as a tap of the presses so far;
+ * - otherwise after the dance's term, as a hold if the key is still held on
+ *   its first press, else as a tap.
+ *
+ * A tap fired while the key is held is held too, until the key is released.
+ * The term counts from the last press or release, as in QMK. Outcomes are
+ * keycodes, pressed with register_code16(), or functions called with true on
+ * press and false on release.
+ *
+ * A keymap binds its dances to custom keycodes, and lists them in a table
+ * indexed by `keycode - SAFE_RANGE`:
+ *
+ *     DANCE_TABLE(
+ *         [BACK_FWD - SAFE_RANGE] = {.tap = {DANCE_KEY(G(KC_LBRC)), DANCE_KEY(G(KC_RBRC))}},
+ *         [BTN2_DRAG - SAFE_RANGE] = {.tap = {DANCE_KEY(KC_BTN2)}, .hold = DANCE_FN(drag), .term = 150},
+ *     );
+ *
+ * Enable in rules.mk with:
+ *
+ *     DANCE_ENABLE = yes
+ *
+ * call `process_dance()` first in `process_record_user()`, and
+ * `timer_service_task()` from `housekeeping_task_user()`.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#define DANCE_MAX_TAPS 3
+
+// Most dance outcomes held down at once.
+#ifndef DANCE_MAX_HELD
+#    define DANCE_MAX_HELD 4
+#endif
+
+/** Function outcome, called with true when it fires and false on release. */
+typedef void (*dance_fn_t)(bool pressed);
+
+/** An outcome, or none if both fields are 0. */
+typedef struct {
+    uint16_t   keycode;
+    dance_fn_t fn;
+} dance_action_t;
+
+#define DANCE_KEY(kc) {.keycode = (kc)}
+#define DANCE_FN(f) {.fn = (f)}
+
+typedef struct {
+    // Outcomes for 1 to DANCE_MAX_TAPS taps.
+    dance_action_t tap[DANCE_MAX_TAPS];
+    // Outcome for holding the first press past the term.
+    dance_action_t hold;
+    // Term in ms, or 0 for TAPPING_TERM.
+    uint16_t term;
+} dance_t;
+
+/**
+ * Defines the keymap's dance table, with designated initializers of the form
+ * `[keycode - SAFE_RANGE] = {...}`.
+ */
+#define DANCE_TABLE(...)                                \
+    const dance_t PROGMEM dance_table[] = {__VA_ARGS__}; \
+    const uint8_t         dance_table_size = ARRAY_SIZE(dance_table)
+
+extern const dance_t dance_table[];
+extern const uint8_t dance_table_size;
+
+/**
+ * Returns true while the dance of `keycode` is on its first press, held, and
+ * may still become a hold.
+ */
+bool dance_can_hold(uint16_t keycode);
+
+/**
+ * Fires the hold of the dance in progress right away, e.g. when the pointer
+ * moves, if `dance_can_hold()` is true for it.
+ */
+void dance_hold(void);
+
+/**
+ * Handler function for dances. Fires the dance in progress when another key
+ * is pressed, and runs the dances of keys in the dance table. Returns false
+ * for keys in the table.
+ */
+bool process_dance(uint16_t keycode, keyrecord_t *record);
@@ -0,0 +1,83 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "decision_trace.h"
+
+_Static_assert(DECISION_TRACE_SIZE > 0 && DECISION_TRACE_SIZE <= 255, "DECISION_TRACE_SIZE must be between 1 and 255");
+
+static decision_trace_record_t records[DECISION_TRACE_SIZE];
+// Index of the next record to write, and number of records in the buffer.
+static uint8_t  head    = 0;
+static uint8_t  count   = 0;
+static uint16_t dropped = 0;
+// Set while the host reads the buffer, from the time of the last read.
+static bool     reading = false;
+static uint16_t read_time;
+
+void decision_trace(uint8_t event, uint16_t keycode, keypos_t key, uint8_t arg) {
+    if (reading && timer_elapsed(read_time) < DECISION_TRACE_READ_TIMEOUT) {
+        ++dropped;
+        return;
+    }
+    reading = false;
+    records[head] = (decision_trace_record_t){
+        .time    = timer_read(),
+        .event   = event,
+        .arg     = arg,
+        .keycode = keycode,
+        .row     = key.row,
+        .col     = key.col,
+    };
+    head = (head + 1) % DECISION_TRACE_SIZE;
+    if (count < DECISION_TRACE_SIZE) {
+        ++count;
+    } else {
+        ++dropped;
+    }
+}
+
+void decision_trace_record(uint16_t keycode, keyrecord_t *record) {
+    if (IS_COMBOEVENT(record->event)) {
+        decision_trace(TRACE_COMBO, keycode, record->event.key, record->event.pressed);
+    } else if (IS_KEYEVENT(record->event)) {
+        decision_trace(record->event.pressed ? TRACE_KEY_PRESS : TRACE_KEY_RELEASE, keycode, record->event.key, record->tap.count);
+    }
+}
+
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+void decision_trace_read(uint8_t *data, uint8_t length) {
+    const uint8_t offset = data[1] < count ? data[1] : count;
+    const uint8_t fit    = (length - DECISION_TRACE_HEADER_SIZE) / DECISION_TRACE_RECORD_SIZE;
+    const uint8_t n      = count - offset < fit ? count - offset : fit;
+    // Freeze the buffer from the first read until the last record is read.
+    reading   = offset + n < count;
+    read_time = timer_read();
+
+    data[1] = count;
+    data[2] = offset;
+    data[3] = n;
+    put_u16(&data[4], timer_read());
+    put_u16(&data[6], dropped);
+    const uint8_t oldest = (head + DECISION_TRACE_SIZE - count) % DECISION_TRACE_SIZE;
+    for (uint8_t i = 0; i < n; ++i) {
+        const decision_trace_record_t *r = &records[(oldest + offset + i) % DECISION_TRACE_SIZE];
+        uint8_t                       *p = &data[DECISION_TRACE_HEADER_SIZE + i * DECISION_TRACE_RECORD_SIZE];
+        put_u16(&p[0], r->time);
+        p[2] = r->event;
+        p[3] = r->arg;
+        put_u16(&p[4], r->keycode);
+        p[6] = r->row;
+        p[7] = r->col;
+    }
+}
+
+void decision_trace_clear(void) {
+    head    = 0;
+    count   = 0;
+    dropped = 0;
+    reading = false;
+}
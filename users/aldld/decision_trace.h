@@ -0,0 +1,101 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file decision_trace.h
+ * @brief Ring buffer of timestamped tap-hold and combo decisions.
+ *
+ * Records key events as seen by `process_record_user()`, Achordion's
+ * decisions, tap flow and combos into a fixed-size buffer in RAM, 8 bytes per
+ * record. The buffer is read over raw HID with tools/hid_tool, which prints it
+ * as a timeline. Unlike dprintf(), this doesn't need CONSOLE_ENABLE and is
+ * cheap enough to leave on while typing normally.
+ *
+ * Enable in rules.mk with:
+ *
+ *     DECISION_TRACE_ENABLE = yes
+ *
+ * and call `decision_trace_record()` at the top of `process_record_user()`.
+ * The buffer holds DECISION_TRACE_SIZE records (default 128, at most 255);
+ * the oldest ones are overwritten.
+ *
+ * When disabled, the functions here compile to nothing, so they can be
+ * called unconditionally.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef DECISION_TRACE_SIZE
+#    define DECISION_TRACE_SIZE 128
+#endif
+// A read left unfinished for this long, in ms, e.g. because the host tool was
+// stopped, unfreezes the buffer.
+#ifndef DECISION_TRACE_READ_TIMEOUT
+#    define DECISION_TRACE_READ_TIMEOUT 1000
+#endif
+
+enum decision_trace_event {
+    // A key event reached process_record_user(). arg: tap count.
+    TRACE_KEY_PRESS = 1,
+    TRACE_KEY_RELEASE,
+    // A combo's keycode was pressed or released. arg: 1 if pressed.
+    TRACE_COMBO,
+    // Tap flow was consulted for a tap-hold key. arg: 1 if it applies.
+    TRACE_TAP_FLOW,
+    // Achordion started tracking a tap-hold key. arg: number tracked.
+    TRACE_ACHORDION_TRACK,
+    // Achordion settled a tap-hold key. arg: reason, enum achordion_reason.
+    TRACE_ACHORDION_HOLD,
+    TRACE_ACHORDION_TAP,
+    // Achordion applied or cleared eager mods. arg: the mods.
+    TRACE_EAGER_APPLY,
+    TRACE_EAGER_CLEAR,
+};
+
+/** A trace record as stored, and as sent over raw HID (little endian). */
+typedef struct {
+    uint16_t time;
+    uint8_t  event;
+    uint8_t  arg;
+    uint16_t keycode;
+    uint8_t  row;
+    uint8_t  col;
+} decision_trace_record_t;
+
+/** Size of a record in raw HID packets. */
+#define DECISION_TRACE_RECORD_SIZE 8
+
+/**
+ * Reply to HID_CMD_TRACE_READ, after the command byte:
+ *
+ *     [1] number of records in the buffer
+ *     [2] offset of the first record in this packet, from the oldest
+ *     [3] number of records in this packet
+ *     [4..5] current time
+ *     [6..7] records dropped, overwritten or while reading
+ *     [8..] records
+ *
+ * Reading from offset 0 freezes the buffer until the last record is read, or
+ * for DECISION_TRACE_READ_TIMEOUT ms after the last read. The next read from
+ * offset 0 starts over.
+ */
+#define DECISION_TRACE_HEADER_SIZE 8
+
+#ifdef DECISION_TRACE_ENABLE
+/** Adds a record to the trace. */
+void decision_trace(uint8_t event, uint16_t keycode, keypos_t key, uint8_t arg);
+
+/** Records a key or combo event. Call from `process_record_user()`. */
+void decision_trace_record(uint16_t keycode, keyrecord_t *record);
+
+/** Handles HID_CMD_TRACE_READ, filling in the reply in `data`. */
+void decision_trace_read(uint8_t *data, uint8_t length);
+
+/** Empties the trace. */
+void decision_trace_clear(void);
+#else
+#    define decision_trace(event, keycode, key, arg)
+#    define decision_trace_record(keycode, record)
+#endif
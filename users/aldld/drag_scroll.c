@@ -0,0 +1,78 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "drag_scroll.h"
+
+_Static_assert(DRAG_SCROLL_DIVISOR_H > 0 && DRAG_SCROLL_DIVISOR_V > 0, "Drag scroll divisors must be positive");
+
+// Most motion counts per report that are turned into scrolling, which keeps
+// the 16.16 products in range.
+#define MAX_MOTION 127
+
+static bool drag_scroll = false;
+// Wheel motion not sent yet, in 1/65536 of a wheel unit.
+static int32_t remainder_h = 0;
+static int32_t remainder_v = 0;
+// Wheel units per count of motion in 16.16, for the resolution they were
+// worked out for. QMK sets the resolution once, at init, from the build's
+// configuration.
+static uint16_t resolution = 0;
+static int32_t  scale_h;
+static int32_t  scale_v;
+
+void drag_scroll_set(bool on) {
+    drag_scroll = on;
+    remainder_h = 0;
+    remainder_v = 0;
+}
+
+bool drag_scroll_is_on(void) {
+    return drag_scroll;
+}
+
+static uint16_t wheel_resolution(void) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    return pointing_device_get_hires_scroll_resolution();
+#else
+    return 1;
+#endif
+}
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high) {
+    return value < low ? low : value > high ? high : value;
+}
+
+// Adds `motion` counts to `remainder` and takes the whole wheel units out.
+static mouse_hv_report_t scroll(int32_t *remainder, int32_t scale, mouse_xy_report_t motion) {
+    *remainder += (int32_t)clamp(motion, -MAX_MOTION, MAX_MOTION) * scale;
+    // Division rounds toward zero, so the remainder keeps the sign of the
+    // motion. Dividing by a power of two needs no divide instruction.
+    const int32_t units = clamp(*remainder / 65536, HV_REPORT_MIN, HV_REPORT_MAX);
+    // Motion beyond what fits in a report is dropped, rather than scrolling
+    // on after the ball stops.
+    *remainder = clamp(*remainder - units * 65536, -65535, 65535);
+    return units;
+}
+
+report_mouse_t drag_scroll_task(report_mouse_t report) {
+    if (!drag_scroll) {
+        return report;
+    }
+    const uint16_t r = wheel_resolution();
+    if (r != resolution) {
+        resolution  = r;
+        scale_h     = (((int32_t)r << 16) + DRAG_SCROLL_DIVISOR_H / 2) / DRAG_SCROLL_DIVISOR_H;
+        scale_v     = (((int32_t)r << 16) + DRAG_SCROLL_DIVISOR_V / 2) / DRAG_SCROLL_DIVISOR_V;
+        remainder_h = 0;
+        remainder_v = 0;
+    }
+    report.h = scroll(&remainder_h, scale_h, report.x);
+#ifdef DRAG_SCROLL_INVERT
+    report.v = scroll(&remainder_v, scale_v, -report.y);
+#else
+    report.v = scroll(&remainder_v, scale_v, report.y);
+#endif
+    report.x = 0;
+    report.y = 0;
+    return report;
+}
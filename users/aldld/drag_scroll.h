@@ -0,0 +1,60 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file drag_scroll.h
+ * @brief Drag scrolling with fixed-point remainders and high-resolution wheels.
+ *
+ * While drag scrolling is on, pointer motion is turned into wheel motion:
+ * DRAG_SCROLL_DIVISOR_H and _V counts of motion per notch. The division is
+ * done in 16.16 fixed point, and the fraction of a step left over from each
+ * report carries over to the next, so slow motion still scrolls, evenly.
+ *
+ * With POINTING_DEVICE_HIRES_SCROLL_ENABLE defined in config.h, wheel motion
+ * is sent in fractions of a notch, 1/POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+ * by default, so slow motion scrolls smoothly rather than a notch at a time.
+ * QMK fixes the resolution at build time and doesn't follow the host's
+ * Resolution Multiplier feature report, so every report is scaled up whatever
+ * the host does. A host that ignores the multiplier then scrolls that many
+ * times too fast. Only enable it after checking that the host honours it.
+ *
+ * This replaces the Ploopy keyboards' own drag scroll, which divides in
+ * floating point, with no FPU on the RP2040, and drops the remainders: leave
+ * their `is_drag_scroll` alone and use `drag_scroll_set()` instead.
+ * DRAG_SCROLL_INVERT reverses vertical scrolling.
+ *
+ * Enable in rules.mk with:
+ *
+ *     DRAG_SCROLL_ENABLE = yes
+ *
+ * and call `drag_scroll_task()` from `pointing_device_task_user()`.
+ *
+ * When disabled, `drag_scroll_task()` returns the report as it is.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef DRAG_SCROLL_DIVISOR_H
+#    define DRAG_SCROLL_DIVISOR_H 60
+#endif
+#ifndef DRAG_SCROLL_DIVISOR_V
+#    define DRAG_SCROLL_DIVISOR_V 60
+#endif
+
+#ifdef DRAG_SCROLL_ENABLE
+/** Turns drag scrolling on or off. */
+void drag_scroll_set(bool on);
+
+/** Returns true while drag scrolling is on. */
+bool drag_scroll_is_on(void);
+
+/**
+ * Turns the report's motion into wheel motion while drag scrolling is on.
+ * Call from `pointing_device_task_user()`.
+ */
+report_mouse_t drag_scroll_task(report_mouse_t report);
+#else
+#    define drag_scroll_task(report) (report)
+#endif
@@ -0,0 +1,55 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "hid_commands.h"
+#include "raw_hid.h"
+#ifdef DECISION_TRACE_ENABLE
+#    include "decision_trace.h"
+#endif
+#ifdef LATENCY_STATS_ENABLE
+#    include "latency_stats.h"
+#endif
+#ifdef IDLE_MODE_ENABLE
+#    include "idle_mode.h"
+#endif
+#ifdef MOTION_COALESCE_ENABLE
+#    include "motion_coalesce.h"
+#endif
+
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    switch (data[0]) {
+#ifdef DECISION_TRACE_ENABLE
+        case HID_CMD_TRACE_READ:
+            decision_trace_read(data, length);
+            break;
+        case HID_CMD_TRACE_CLEAR:
+            decision_trace_clear();
+            break;
+#endif
+#ifdef LATENCY_STATS_ENABLE
+        case HID_CMD_LATENCY_READ:
+            latency_stats_read(data, length);
+            break;
+        case HID_CMD_LATENCY_CLEAR:
+            latency_stats_clear();
+            break;
+#endif
+#ifdef IDLE_MODE_ENABLE
+        case HID_CMD_IDLE_READ:
+            idle_mode_read(data, length);
+            break;
+#endif
+#ifdef MOTION_COALESCE_ENABLE
+        case HID_CMD_MOTION_READ:
+            motion_coalesce_read(data, length);
+            break;
+        case HID_CMD_MOTION_CLEAR:
+            motion_coalesce_clear();
+            break;
+#endif
+        default:
+            data[0] = HID_CMD_UNSUPPORTED;
+            break;
+    }
+    raw_hid_send(data, length);
+}
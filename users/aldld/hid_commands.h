@@ -0,0 +1,39 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file hid_commands.h
+ * @brief Raw HID commands shared by the userspace features and host tools.
+ *
+ * Every packet from the host starts with a command byte. The reply is sent in
+ * the same buffer and starts with the same command byte, or
+ * HID_CMD_UNSUPPORTED if the firmware wasn't built with the feature.
+ *
+ * Raw HID is also used by Oryx, so HID_COMMANDS_ENABLE requires
+ * ORYX_ENABLE = no.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+enum hid_command {
+    // Reads decision trace records. Request: [cmd, offset].
+    HID_CMD_TRACE_READ = 0x01,
+    // Empties the decision trace. Request: [cmd].
+    HID_CMD_TRACE_CLEAR = 0x02,
+    // Reads a latency histogram. Request: [cmd, histogram].
+    HID_CMD_LATENCY_READ = 0x03,
+    // Resets the latency histograms. Request: [cmd].
+    HID_CMD_LATENCY_CLEAR = 0x04,
+    // Reads the idle mode's wake-up measurements. Request: [cmd].
+    HID_CMD_IDLE_READ = 0x05,
+    // Reads the motion coalescing measurements. Request: [cmd].
+    HID_CMD_MOTION_READ = 0x06,
+    // Resets the motion coalescing measurements. Request: [cmd].
+    HID_CMD_MOTION_CLEAR = 0x07,
+    HID_CMD_UNSUPPORTED = 0xFF,
+};
+
+/** Size of raw HID packets. */
+#define HID_COMMAND_SIZE 32
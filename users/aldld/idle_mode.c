@@ -0,0 +1,164 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "idle_mode.h"
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#endif
+
+#define REPORT_TIMEOUT_US (IDLE_MODE_REPORT_TIMEOUT * 1000UL)
+
+static idle_mode_stats_t stats;
+// Running averages in 1/16 us.
+static uint32_t idle_sum  = 0;
+static uint32_t awake_sum = 0;
+#ifdef RGB_MATRIX_ENABLE
+// Effect speed to restore on waking up.
+static uint8_t rgb_speed;
+#endif
+// The reports as of the last scan before the matrix change being measured.
+static report_keyboard_t last_report;
+#ifdef NKRO_ENABLE
+static report_nkro_t last_nkro_report;
+#endif
+// Time of the last pass, before sleeping, which is just after its scan.
+static uint32_t last_scan;
+static bool     scanned = false;
+static uint32_t activity_time;
+// The matrix change being measured: the scan before it, and whether it was
+// seen while idle.
+static bool     measuring = false;
+static uint32_t change_time;
+static bool     change_idle;
+
+// Time in us, wrapping. The system timer of the RP2040 counts in us, the
+// timer_read32() millisecond clock is too coarse next to a 1 ms sleep.
+static uint32_t now_us(void) {
+#ifdef PROTOCOL_CHIBIOS
+    return TIME_I2US(chVTGetSystemTimeX());
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static void go_idle(void) {
+    stats.idle = true;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_speed = rgb_matrix_get_speed();
+    rgb_matrix_set_speed_noeeprom(IDLE_MODE_RGB_SPEED);
+#endif
+}
+
+static void wake_up(void) {
+    stats.idle = false;
+    ++stats.wakes;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_set_speed_noeeprom(rgb_speed);
+#endif
+}
+
+static void save_report(void) {
+    memcpy(&last_report, keyboard_report, sizeof(last_report));
+#ifdef NKRO_ENABLE
+    memcpy(&last_nkro_report, nkro_report, sizeof(last_nkro_report));
+#endif
+}
+
+static bool report_changed(void) {
+#ifdef NKRO_ENABLE
+    if (memcmp(nkro_report, &last_nkro_report, sizeof(last_nkro_report)) != 0) {
+        return true;
+    }
+#endif
+    return memcmp(keyboard_report, &last_report, sizeof(last_report)) != 0;
+}
+
+static void add_sample(idle_mode_latency_t *latency, uint32_t *sum, uint32_t sample) {
+    const uint16_t value = MIN(sample, UINT16_MAX);
+    ++latency->count;
+    if (value > latency->max_latency) {
+        latency->max_latency = value;
+    }
+    *sum                 = *sum - *sum / 16 + value;
+    latency->avg_latency = *sum / 16;
+}
+
+// Ends the measurement once the report changed. The key may have been
+// reported already, in the pass of the main loop that saw it.
+static void measure(uint32_t now) {
+    const uint32_t latency = now - change_time;
+    if (latency > REPORT_TIMEOUT_US) {
+        measuring = false;
+        return;
+    }
+    if (!report_changed()) {
+        return;
+    }
+    measuring = false;
+    if (change_idle) {
+        add_sample(&stats.idle_latency, &idle_sum, latency);
+    } else {
+        add_sample(&stats.awake_latency, &awake_sum, latency);
+    }
+}
+
+void idle_mode_task(void) {
+    const uint32_t now = now_us();
+    if (scanned && !measuring && last_matrix_activity_time() != activity_time) {
+        // The change happened after the scan of the last pass, and before
+        // the sleep that followed it ended, if idle.
+        measuring   = true;
+        change_time = last_scan;
+        change_idle = stats.idle;
+    }
+    activity_time = last_matrix_activity_time();
+    scanned       = true;
+    last_scan     = now;
+    if (measuring) {
+        measure(now);
+    }
+    if (!measuring) {
+        save_report();
+    }
+
+    if (!stats.idle) {
+        if (last_matrix_activity_elapsed() >= IDLE_MODE_TIMEOUT) {
+            go_idle();
+        }
+        return;
+    }
+    if (last_matrix_activity_elapsed() < IDLE_MODE_TIMEOUT) {
+        wake_up();
+        return;
+    }
+    wait_ms(IDLE_MODE_SCAN_INTERVAL);
+}
+
+bool idle_mode_is_idle(void) {
+    return stats.idle;
+}
+
+idle_mode_stats_t idle_mode_get_stats(void) {
+    return stats;
+}
+
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void put_latency(uint8_t *p, const idle_mode_latency_t *latency) {
+    put_u16(&p[0], latency->count);
+    put_u16(&p[2], latency->avg_latency);
+    put_u16(&p[4], latency->max_latency);
+}
+
+void idle_mode_read(uint8_t *data, uint8_t length) {
+    if (length < IDLE_MODE_REPLY_SIZE) {
+        return;
+    }
+    data[1] = stats.idle;
+    put_u16(&data[2], stats.wakes);
+    put_latency(&data[4], &stats.idle_latency);
+    put_latency(&data[10], &stats.awake_latency);
+}
@@ -0,0 +1,100 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file idle_mode.h
+ * @brief Scans slower and slows the RGB animation while nobody types.
+ *
+ * After IDLE_MODE_TIMEOUT ms without any change in the matrix, the keyboard
+ * goes idle: each pass of the main loop sleeps IDLE_MODE_SCAN_INTERVAL ms,
+ * which lowers the scan rate from several kHz to about 1 kHz and lets the MCU
+ * wait for interrupts in between, and the RGB Matrix effect speed drops to
+ * IDLE_MODE_RGB_SPEED, so the animation changes the LEDs, and sends updates
+ * to the LED drivers, less often. The first change in the matrix wakes the
+ * keyboard up and restores the effect speed.
+ *
+ * A press that comes during a sleep is seen at the end of it, so the sleep
+ * must stay short for the first key not to be late. To check that it is,
+ * matrix changes are timed the same way while idle and while awake, in us:
+ * from the last scan before the change, which is before the sleep when idle,
+ * to the first keyboard report that differs from the one at that scan. This
+ * is the most the key could have waited, since it was pressed after that
+ * scan. The figures for changes seen while idle and while awake are kept
+ * apart, and the difference between them is what sleeping costs. Read them
+ * with `idle_mode_get_stats()`, or over raw HID with
+ * `tools/hid_tool <device> idle`, which needs HID_COMMANDS_ENABLE and so
+ * ORYX_ENABLE = no.
+ *
+ * Enable in rules.mk with:
+ *
+ *     IDLE_MODE_ENABLE = yes
+ *
+ * and call `idle_mode_task()` from `housekeeping_task_user()`.
+ *
+ * When disabled, `idle_mode_task()` compiles to nothing.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef IDLE_MODE_TIMEOUT
+#    define IDLE_MODE_TIMEOUT 30000
+#endif
+#ifndef IDLE_MODE_SCAN_INTERVAL
+#    define IDLE_MODE_SCAN_INTERVAL 1
+#endif
+#ifndef IDLE_MODE_RGB_SPEED
+#    define IDLE_MODE_RGB_SPEED 0
+#endif
+// Matrix changes whose first report takes longer than this, in ms, e.g.
+// because the key only sends a consumer or mouse report, aren't measured.
+#ifndef IDLE_MODE_REPORT_TIMEOUT
+#    define IDLE_MODE_REPORT_TIMEOUT 1000
+#endif
+
+typedef struct {
+    // Matrix changes measured.
+    uint16_t count;
+    // Scan before the change to report, in us: running average over about 16
+    // changes, and the most.
+    uint16_t avg_latency;
+    uint16_t max_latency;
+} idle_mode_latency_t;
+
+typedef struct {
+    uint16_t            wakes;
+    idle_mode_latency_t idle_latency;
+    idle_mode_latency_t awake_latency;
+    bool                idle;
+} idle_mode_stats_t;
+
+/**
+ * Reply to HID_CMD_IDLE_READ, request [cmd], after the command byte:
+ *
+ *     [1] 1 if idle
+ *     [2..3] number of wake-ups
+ *     [4..5] changes measured while idle
+ *     [6..7] average latency while idle in us
+ *     [8..9] maximum latency while idle in us
+ *     [10..11] changes measured while awake
+ *     [12..13] average latency while awake in us
+ *     [14..15] maximum latency while awake in us
+ */
+#define IDLE_MODE_REPLY_SIZE 16
+
+#ifdef IDLE_MODE_ENABLE
+/** Goes idle, sleeps or wakes up. Call from `housekeeping_task_user()`. */
+void idle_mode_task(void);
+
+/** Returns true while idle. */
+bool idle_mode_is_idle(void);
+
+/** Returns the latency measurements. */
+idle_mode_stats_t idle_mode_get_stats(void);
+
+/** Handles HID_CMD_IDLE_READ, filling in the reply in `data`. */
+void idle_mode_read(uint8_t *data, uint8_t length);
+#else
+#    define idle_mode_task()
+#endif
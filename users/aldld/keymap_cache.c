@@ -0,0 +1,72 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keymap_cache.h"
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    error "The keymap cache doesn't support dynamic keymaps"
+#endif
+#ifdef ENCODER_MAP_ENABLE
+#    error "The keymap cache doesn't support encoder maps"
+#endif
+
+typedef struct {
+    uint16_t keycode;
+    uint8_t  layer;
+    uint8_t  generation; // 0 for entries never filled in.
+} cache_entry_t;
+
+static cache_entry_t cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t cached_state = 0;
+static uint8_t       generation   = 1;
+
+static void resolve(cache_entry_t *entry, keypos_t key, layer_state_t state) {
+    entry->layer      = 0;
+    entry->generation = generation;
+    for (int8_t layer = MAX_LAYER - 1; layer > 0; --layer) {
+        if (!(state & ((layer_state_t)1 << layer))) {
+            continue;
+        }
+        const uint16_t keycode = keycode_at_keymap_location(layer, key.row, key.col);
+        if (keycode != KC_TRNS) {
+            entry->keycode = keycode;
+            entry->layer   = layer;
+            return;
+        }
+    }
+    // As in layer_switch_get_layer(), keys transparent on every active layer
+    // come from layer 0.
+    entry->keycode = keycode_at_keymap_location(0, key.row, key.col);
+}
+
+static const cache_entry_t *lookup(keypos_t key) {
+    const layer_state_t state = layer_state | default_layer_state;
+    if (state != cached_state) {
+        cached_state = state;
+        if (++generation == 0) {
+            // Entries from 256 layer changes ago would look fresh again.
+            memset(cache, 0, sizeof(cache));
+            generation = 1;
+        }
+    }
+    cache_entry_t *entry = &cache[key.row][key.col];
+    if (entry->generation != generation) {
+        resolve(entry, key, state);
+    }
+    return entry;
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+    const cache_entry_t *entry = lookup(key);
+    if (layer == entry->layer) {
+        return entry->keycode;
+    }
+    // Active layers above the resolved one are transparent for this key.
+    if (layer > entry->layer && layer < MAX_LAYER && (cached_state & ((layer_state_t)1 << layer))) {
+        return KC_TRNS;
+    }
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
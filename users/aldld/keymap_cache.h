@@ -0,0 +1,31 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file keymap_cache.h
+ * @brief Caches the keycode each key resolves to under the active layers.
+ *
+ * To find what a key does, QMK walks down the active layers reading the
+ * keymap from flash until it finds a key that isn't transparent. On layers
+ * that are mostly `_______`, that is several reads per key event. The cache
+ * keeps, for every matrix position, the layer the key resolved to and its
+ * keycode there. QMK's walk then only reads the cache: layers above the
+ * resolved one are known to be transparent, and the resolved one gives the
+ * cached keycode.
+ *
+ * Entries are tagged with a generation that is bumped whenever the active
+ * layers (`layer_state | default_layer_state`) differ from the last lookup,
+ * so a layer change costs nothing up front and each key is resolved again
+ * the first time it is looked up afterwards.
+ *
+ * Enable in rules.mk with:
+ *
+ *     KEYMAP_CACHE_ENABLE = yes
+ *
+ * The cache overrides QMK's weak `keymap_key_to_keycode()`, so it can't be
+ * combined with keymaps that change at run time or with encoder maps.
+ */
+
+#pragma once
+
+#include "quantum.h"
@@ -0,0 +1,129 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_stats.h"
+#include "host.h"
+
+// Presses waiting for their report. A press whose report doesn't come within
+// LATENCY_STATS_MAX_WAIT ms is dropped.
+#define LATENCY_STATS_MAX_PENDING 4
+#define LATENCY_STATS_MAX_WAIT 1000
+
+typedef struct {
+    uint16_t time;
+    uint8_t  path;
+    uint8_t  layer;
+} pending_press_t;
+
+static pending_press_t pending[LATENCY_STATS_MAX_PENDING];
+static uint8_t         num_pending = 0;
+static uint16_t        histograms[LATENCY_NUM_HISTOGRAMS][LATENCY_NUM_BUCKETS];
+static uint16_t        max_latency[LATENCY_NUM_HISTOGRAMS];
+
+// Defined by Achordion when it is built in.
+__attribute__((weak)) bool achordion_plumbing(void) {
+    return false;
+}
+
+// Returns true if pressing `keycode` changes the keyboard report.
+static bool changes_report(uint16_t keycode, keyrecord_t *record) {
+    if (IS_QK_LAYER_TAP(keycode)) {
+        return record->tap.count > 0;
+    }
+    return IS_QK_MOD_TAP(keycode) || IS_BASIC_KEYCODE(keycode) || IS_MODIFIER_KEYCODE(keycode) || IS_QK_MODS(keycode);
+}
+
+static uint8_t decision_path(uint16_t keycode, keyrecord_t *record) {
+    if (IS_COMBOEVENT(record->event)) {
+        return LATENCY_PATH_COMBO;
+    }
+    if (achordion_plumbing()) {
+        return LATENCY_PATH_ACHORDION;
+    }
+    if (!IS_QK_MOD_TAP(keycode) && !IS_QK_LAYER_TAP(keycode)) {
+        return LATENCY_PATH_INSTANT;
+    }
+    const uint16_t waited = timer_elapsed(record->event.time);
+    return record->tap.count == 0 && waited >= GET_TAPPING_TERM(keycode, record) ? LATENCY_PATH_TIMEOUT : LATENCY_PATH_TAP_HOLD;
+}
+
+void latency_stats_record(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed || !changes_report(keycode, record)) {
+        return;
+    }
+    if (num_pending == LATENCY_STATS_MAX_PENDING) {
+        memmove(&pending[0], &pending[1], sizeof(pending) - sizeof(pending[0]));
+        --num_pending;
+    }
+    pending[num_pending++] = (pending_press_t){
+        .time  = record->event.time,
+        .path  = decision_path(keycode, record),
+        .layer = get_highest_layer(layer_state | default_layer_state),
+    };
+}
+
+static void count(uint8_t histogram, uint16_t latency) {
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_NUM_BUCKETS - 1 && (latency >> bucket) != 0) {
+        ++bucket;
+    }
+    if (histograms[histogram][bucket] < UINT16_MAX) {
+        ++histograms[histogram][bucket];
+    }
+    if (latency > max_latency[histogram]) {
+        max_latency[histogram] = latency;
+    }
+}
+
+// Called when a report goes to the host: it carries every pending press.
+static void report_sent(void) {
+    const uint16_t now = timer_read();
+    for (uint8_t i = 0; i < num_pending; ++i) {
+        const uint16_t latency = now - pending[i].time;
+        if (latency > LATENCY_STATS_MAX_WAIT) {
+            continue;
+        }
+        count(pending[i].path, latency);
+        if (pending[i].layer < LATENCY_STATS_LAYERS) {
+            count(LATENCY_NUM_PATHS + pending[i].layer, latency);
+        }
+    }
+    num_pending = 0;
+}
+
+void __real_host_keyboard_send(report_keyboard_t *report);
+void __wrap_host_keyboard_send(report_keyboard_t *report) {
+    report_sent();
+    __real_host_keyboard_send(report);
+}
+
+void __real_host_nkro_send(report_nkro_t *report);
+void __wrap_host_nkro_send(report_nkro_t *report) {
+    report_sent();
+    __real_host_nkro_send(report);
+}
+
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+void latency_stats_read(uint8_t *data, uint8_t length) {
+    const uint8_t histogram = data[1];
+    data[2]                 = LATENCY_NUM_HISTOGRAMS;
+    data[3]                 = LATENCY_NUM_BUCKETS;
+    if (histogram >= LATENCY_NUM_HISTOGRAMS || length < LATENCY_STATS_HEADER_SIZE + 2 * LATENCY_NUM_BUCKETS) {
+        data[3] = 0;
+        return;
+    }
+    put_u16(&data[4], max_latency[histogram]);
+    for (uint8_t b = 0; b < LATENCY_NUM_BUCKETS; ++b) {
+        put_u16(&data[LATENCY_STATS_HEADER_SIZE + 2 * b], histograms[histogram][b]);
+    }
+}
+
+void latency_stats_clear(void) {
+    memset(histograms, 0, sizeof(histograms));
+    memset(max_latency, 0, sizeof(max_latency));
+    num_pending = 0;
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file latency_stats.h
+ * @brief Histograms of the time from key detection to the host report.
+ *
+ * For each key press that changes the keyboard report, measures the time from
+ * the matrix scan that detected it (`record->event.time`) to the next report
+ * sent to the host, and counts it in two histograms: one for the layer it was
+ * pressed on and one for how its tap-hold decision was made. Read the results
+ * over raw HID with `tools/hid_tool <device> latency`.
+ *
+ * Enable in rules.mk with:
+ *
+ *     LATENCY_STATS_ENABLE = yes
+ *
+ * and call `latency_stats_record()` at the top of `process_record_user()`.
+ * Reports are caught by wrapping host_keyboard_send() and host_nkro_send() at
+ * link time.
+ *
+ * When disabled, `latency_stats_record()` compiles to nothing.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+/** How a key press got its meaning. */
+enum latency_path {
+    // Not a tap-hold key, sent as soon as it was detected.
+    LATENCY_PATH_INSTANT,
+    // Tap-hold key decided by QMK before its tapping term, e.g. on release,
+    // by Permissive Hold or by Chordal Hold.
+    LATENCY_PATH_TAP_HOLD,
+    // Tap-hold key decided by Achordion.
+    LATENCY_PATH_ACHORDION,
+    // Tap-hold key held until its tapping term or Achordion timeout.
+    LATENCY_PATH_TIMEOUT,
+    // Combo.
+    LATENCY_PATH_COMBO,
+    LATENCY_NUM_PATHS,
+};
+
+#ifndef LATENCY_STATS_LAYERS
+#    define LATENCY_STATS_LAYERS 8
+#endif
+
+/**
+ * Histograms are numbered with the paths first, then the layers. Bucket 0
+ * counts latencies of 0 ms, bucket b > 0 those from 2^(b-1) to 2^b - 1 ms,
+ * and the last bucket everything above.
+ */
+#define LATENCY_NUM_HISTOGRAMS (LATENCY_NUM_PATHS + LATENCY_STATS_LAYERS)
+#define LATENCY_NUM_BUCKETS 12
+
+/**
+ * Reply to HID_CMD_LATENCY_READ, request [cmd, histogram], after the command
+ * byte:
+ *
+ *     [1] histogram
+ *     [2] number of histograms
+ *     [3] number of buckets
+ *     [4..5] maximum latency in ms
+ *     [6..] counts per bucket, 16 bits each
+ */
+#define LATENCY_STATS_HEADER_SIZE 6
+
+#ifdef LATENCY_STATS_ENABLE
+/** Notes a key event. Call from `process_record_user()`. */
+void latency_stats_record(uint16_t keycode, keyrecord_t *record);
+
+/** Handles HID_CMD_LATENCY_READ, filling in the reply in `data`. */
+void latency_stats_read(uint8_t *data, uint8_t length);
+
+/** Resets all histograms. */
+void latency_stats_clear(void);
+#else
+#    define latency_stats_record(keycode, record)
+#endif
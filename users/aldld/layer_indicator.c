@@ -0,0 +1,98 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "layer_indicator.h"
+
+// Colors of the LEDs as of the last update, and the LEDs to write.
+static rgb_t   colors[RGB_MATRIX_LED_COUNT];
+static uint8_t dirty[(RGB_MATRIX_LED_COUNT + 7) / 8];
+// What the colors show.
+static layer_state_t shown_layers;
+static uint8_t       shown_mods;
+static uint8_t       shown_val;
+static bool          shown = false;
+
+// Keymaps without layer colors get every LED off.
+__attribute__((weak)) const hsv_t   layer_indicator_colors[] = {{0, 0, 0}};
+__attribute__((weak)) const uint8_t layer_indicator_num_colors = 0;
+
+static hsv_t layer_color(uint8_t layer) {
+    if (layer >= layer_indicator_num_colors) {
+        return (hsv_t){0, 0, 0};
+    }
+    hsv_t hsv;
+    memcpy_P(&hsv, &layer_indicator_colors[layer], sizeof(hsv));
+    return hsv;
+}
+
+static void set_color(uint8_t led, hsv_t hsv) {
+    hsv.v           = scale8(hsv.v, shown_val);
+    const rgb_t rgb = hsv_to_rgb(hsv);
+    if (rgb.r != colors[led].r || rgb.g != colors[led].g || rgb.b != colors[led].b) {
+        colors[led] = rgb;
+        dirty[led / 8] |= 1 << (led % 8);
+    }
+}
+
+// Returns the 8-bit mods of a mod-tap keycode, or 0 for other keycodes.
+static uint8_t mod_tap_mods(uint16_t keycode) {
+    if (!IS_QK_MOD_TAP(keycode)) {
+        return 0;
+    }
+    const uint8_t mods = QK_MOD_TAP_GET_MODS(keycode);
+    return mods & MOD_RMOD_MASK ? (mods & 0x0F) << 4 : mods;
+}
+
+// Works out the colors again if what they show changed.
+static void update(void) {
+    const layer_state_t layers = layer_state | default_layer_state;
+    const uint8_t       mods   = get_mods() | get_oneshot_mods();
+    const uint8_t       val    = rgb_matrix_get_val();
+    if (shown && layers == shown_layers && mods == shown_mods && val == shown_val) {
+        return;
+    }
+    shown        = true;
+    shown_layers = layers;
+    shown_mods   = mods;
+    shown_val    = val;
+
+    const uint8_t layer         = get_highest_layer(layers);
+    const uint8_t default_layer = get_highest_layer(default_layer_state);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; ++i) {
+        if (!HAS_FLAGS(g_led_config.flags[i], LED_FLAG_KEYLIGHT)) {
+            set_color(i, layer_color(layer));
+        }
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            const uint8_t led = g_led_config.matrix_co[row][col];
+            if (led == NO_LED) {
+                continue;
+            }
+            const keypos_t key = {.row = row, .col = col};
+            if (mods & mod_tap_mods(keymap_key_to_keycode(default_layer, key))) {
+                set_color(led, (hsv_t){LAYER_INDICATOR_MOD_COLOR});
+            } else if (layer != default_layer && keymap_key_to_keycode(layer, key) == KC_TRNS) {
+                set_color(led, layer_color(default_layer));
+            } else {
+                set_color(led, layer_color(layer));
+            }
+        }
+    }
+}
+
+bool layer_indicator_render(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+    if (params->init) {
+        // Whatever was shown before left its own colors.
+        memset(dirty, 0xFF, sizeof(dirty));
+    }
+    update();
+    for (uint8_t i = led_min; i < led_max; ++i) {
+        if (dirty[i / 8] & (1 << (i % 8))) {
+            dirty[i / 8] &= ~(1 << (i % 8));
+            rgb_matrix_set_color(i, colors[i].r, colors[i].g, colors[i].b);
+        }
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
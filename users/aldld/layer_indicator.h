@@ -0,0 +1,53 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file layer_indicator.h
+ * @brief RGB Matrix effect showing the layer and the held home row mods.
+ *
+ * The LAYER_INDICATOR effect lights every key in the color of the highest
+ * active layer, except keys that are transparent on it, which keep the
+ * color of the default layer. Mod-tap keys of the default layer whose mods
+ * are held, e.g. the home row mods, are lit in LAYER_INDICATOR_MOD_COLOR.
+ * Colors are given at full brightness and scaled to the RGB Matrix value.
+ *
+ * The colors are worked out only when the layers, the mods or the brightness
+ * change, and each frame writes only the LEDs whose color changed since the
+ * last one. A frame with no change writes none, so the LED driver has
+ * nothing to flush. Indicators that write over the effect's LEDs and then
+ * stop may leave them stale until the next change.
+ *
+ * Enable in rules.mk with:
+ *
+ *     LAYER_INDICATOR_ENABLE = yes
+ *
+ * list the layer colors in keymap.c, indexed by layer:
+ *
+ *     LAYER_INDICATOR_COLORS([_BASE] = {HSV_WHITE}, [_NUM] = {HSV_BLUE}, ...);
+ *
+ * and select the effect with
+ * `rgb_matrix_mode(RGB_MATRIX_CUSTOM_LAYER_INDICATOR)`. Layers without a
+ * color are off.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef LAYER_INDICATOR_MOD_COLOR
+#    define LAYER_INDICATOR_MOD_COLOR HSV_WHITE
+#endif
+
+/**
+ * Defines the keymap's layer colors, with designated initializers of the
+ * form `[layer] = {HSV_...}`.
+ */
+#define LAYER_INDICATOR_COLORS(...)                                   \
+    const hsv_t PROGMEM layer_indicator_colors[] = {__VA_ARGS__}; \
+    const uint8_t       layer_indicator_num_colors = ARRAY_SIZE(layer_indicator_colors)
+
+extern const hsv_t   layer_indicator_colors[];
+extern const uint8_t layer_indicator_num_colors;
+
+/** Renders the effect. Called from rgb_matrix_user.inc. */
+bool layer_indicator_render(effect_params_t *params);
@@ -0,0 +1,171 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "macro_player.h"
+#include "timer_service.h"
+
+// Most keys a macro may hold down at once with SS_DOWN() or MACRO_DOWN().
+#define MACRO_PLAYER_MAX_HELD 4
+
+// The next byte to play, of a SEND_STRING string or of bytecode.
+static const char     *next_char    = NULL;
+static bool            playing_code = false;
+static timer_token_t   step_token   = TIMER_SERVICE_INVALID_TOKEN;
+static uint8_t         held[MACRO_PLAYER_MAX_HELD];
+static uint8_t         num_held     = 0;
+static uint8_t         held_mods    = 0;
+
+// Keymaps without bytecode macros get an empty table.
+__attribute__((weak)) const uint8_t *const macro_table[] = {NULL};
+__attribute__((weak)) const uint8_t        macro_table_size = 0;
+
+static void hold_key(uint8_t keycode) {
+    register_code(keycode);
+    if (num_held < MACRO_PLAYER_MAX_HELD) {
+        held[num_held++] = keycode;
+    }
+}
+
+static void release_key(uint8_t keycode) {
+    unregister_code(keycode);
+    for (uint8_t i = 0; i < num_held; ++i) {
+        if (held[i] == keycode) {
+            held[i] = held[--num_held];
+            break;
+        }
+    }
+}
+
+// Sends keystrokes from `next_char` up to the next delay or the end of the
+// string. Returns the delay in ms, or 0 once the macro is done.
+static uint32_t play_string_until_delay(void) {
+    for (char c; (c = pgm_read_byte(next_char)) != '\0'; ++next_char) {
+        if (c != SS_QMK_PREFIX) {
+            send_char(c);
+            continue;
+        }
+        const char code = pgm_read_byte(++next_char);
+        if (code == SS_TAP_CODE) {
+            tap_code(pgm_read_byte(++next_char));
+        } else if (code == SS_DOWN_CODE) {
+            hold_key(pgm_read_byte(++next_char));
+        } else if (code == SS_UP_CODE) {
+            release_key(pgm_read_byte(++next_char));
+        } else if (code == SS_DELAY_CODE) {
+            uint32_t ms = 0;
+            while ((c = pgm_read_byte(++next_char)) >= '0' && c <= '9') {
+                ms = ms * 10 + (c - '0');
+            }
+            // `next_char` is on the '|' that ends the delay.
+            if (ms > 0) {
+                ++next_char;
+                return ms;
+            }
+        }
+    }
+    next_char = NULL;
+    return 0;
+}
+
+static void set_mods(uint8_t mods) {
+    unregister_mods(held_mods & ~mods);
+    register_mods(mods & ~held_mods);
+    held_mods = mods;
+}
+
+// As above, for bytecode.
+static uint32_t play_code_until_delay(void) {
+    for (uint8_t op; (op = pgm_read_byte(next_char++)) != MACRO_OP_END;) {
+        const uint8_t arg = pgm_read_byte(next_char++);
+        switch (op) {
+            case MACRO_OP_TAP:
+                tap_code(arg);
+                break;
+            case MACRO_OP_DOWN:
+                hold_key(arg);
+                break;
+            case MACRO_OP_UP:
+                release_key(arg);
+                break;
+            case MACRO_OP_MODS:
+                set_mods(arg);
+                break;
+            case MACRO_OP_DELAY: {
+                const uint16_t ms = arg | pgm_read_byte(next_char++) << 8;
+                if (ms > 0) {
+                    return ms;
+                }
+                break;
+            }
+        }
+    }
+    set_mods(0);
+    next_char = NULL;
+    return 0;
+}
+
+static uint32_t play_until_delay(void) {
+    return playing_code ? play_code_until_delay() : play_string_until_delay();
+}
+
+static uint32_t macro_player_step(uint32_t deadline, void *arg) {
+    const uint32_t delay = play_until_delay();
+    if (delay == 0) {
+        step_token = TIMER_SERVICE_INVALID_TOKEN;
+    }
+    return delay;
+}
+
+static void play(const char *start, bool code) {
+    macro_player_cancel();
+    next_char            = start;
+    playing_code         = code;
+    const uint32_t delay = play_until_delay();
+    if (delay > 0) {
+        step_token = timer_service_start(delay, macro_player_step, NULL);
+        if (step_token == TIMER_SERVICE_INVALID_TOKEN) {
+            macro_player_cancel(); // No timer free.
+        }
+    }
+}
+
+void macro_play_P(const char *str) {
+    play(str, false);
+}
+
+void macro_play_code_P(const uint8_t *code) {
+    play((const char *)code, true);
+}
+
+bool macro_player_is_playing(void) {
+    return next_char != NULL;
+}
+
+void macro_player_cancel(void) {
+    if (step_token != TIMER_SERVICE_INVALID_TOKEN) {
+        timer_service_cancel(step_token);
+        step_token = TIMER_SERVICE_INVALID_TOKEN;
+    }
+    while (num_held > 0) {
+        unregister_code(held[--num_held]);
+    }
+    set_mods(0);
+    next_char = NULL;
+}
+
+bool process_macro_player(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed && macro_player_is_playing()) {
+        macro_player_cancel();
+    }
+    if (keycode < SAFE_RANGE || keycode - SAFE_RANGE >= macro_table_size) {
+        return true;
+    }
+    const uint8_t *code = pgm_read_ptr(&macro_table[keycode - SAFE_RANGE]);
+    if (code == NULL) {
+        return true;
+    }
+    if (record->event.pressed) {
+        macro_play_code_P(code);
+    }
+    return false;
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file macro_player.h
+ * @brief Plays SEND_STRING macros without blocking the keyboard.
+ *
+ * SEND_STRING() waits out each SS_DELAY() with wait_ms(), so no keys are
+ * scanned until the whole macro is typed. The macro player takes the same
+ * strings but sends each run of keystrokes between delays from a timer of
+ * timer_service.h, and the keyboard keeps running in the meantime:
+ *
+ *     MACRO_PLAY(SS_TAP(X_ESCAPE) SS_DELAY(100) SS_TAP(X_ENTER));
+ *
+ * Keystrokes before the first delay are sent right away. Pressing another key
+ * while a macro is playing cancels the rest of it, releasing any key the macro
+ * holds down; starting a macro also cancels the one that is playing.
+ *
+ * Macros bound to custom keycodes are better written as bytecode, which
+ * takes a few bytes per keystroke and needs no code of its own. A keymap
+ * lists them in a table indexed by `keycode - SAFE_RANGE`, and
+ * `process_macro_player()` plays the macro of any key in the table:
+ *
+ *     MACRO_DEFINE(md_link, MACRO_TAP(KC_LBRC), MACRO_TAP(KC_RBRC),
+ *                  MACRO_TAP_MODS(MOD_BIT(KC_LSFT), KC_9), ...);
+ *     MACRO_TABLE([MD_LINK - SAFE_RANGE] = md_link);
+ *
+ * Enable in rules.mk with:
+ *
+ *     MACRO_PLAYER_ENABLE = yes
+ *
+ * call `process_macro_player()` from `process_record_user()`, before
+ * starting any macro, and `timer_service_task()` from
+ * `housekeeping_task_user()`.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+/** Starts playing a SEND_STRING-encoded string stored in PROGMEM. */
+void macro_play_P(const char *str);
+
+/** Starts playing a string literal, as with SEND_STRING(). */
+#define MACRO_PLAY(string) macro_play_P(PSTR(string))
+
+/** Bytecode operations, each followed by its arguments. */
+enum macro_op {
+    MACRO_OP_END = 0,
+    // Taps, presses or releases a basic keycode. Argument: keycode.
+    MACRO_OP_TAP,
+    MACRO_OP_DOWN,
+    MACRO_OP_UP,
+    // Holds exactly the given modifiers. Argument: 8-bit mods, as MOD_BIT().
+    MACRO_OP_MODS,
+    // Waits. Argument: 16-bit delay in ms, low byte first.
+    MACRO_OP_DELAY,
+};
+
+#define MACRO_TAP(kc) MACRO_OP_TAP, (kc)
+#define MACRO_DOWN(kc) MACRO_OP_DOWN, (kc)
+#define MACRO_UP(kc) MACRO_OP_UP, (kc)
+#define MACRO_MODS(mods) MACRO_OP_MODS, (mods)
+#define MACRO_DELAY(ms) MACRO_OP_DELAY, ((ms) & 0xFF), ((ms) >> 8)
+/** Taps `kc` with `mods` held, then releases the mods. */
+#define MACRO_TAP_MODS(mods, kc) MACRO_MODS(mods), MACRO_TAP(kc), MACRO_MODS(0)
+
+/** Defines a bytecode macro `name` from a list of the operations above. */
+#define MACRO_DEFINE(name, ...) static const uint8_t PROGMEM name[] = {__VA_ARGS__, MACRO_OP_END}
+
+/**
+ * Defines the keymap's macro table, with designated initializers of the form
+ * `[keycode - SAFE_RANGE] = name`. Keycodes without a macro are left NULL.
+ */
+#define MACRO_TABLE(...)                                        \
+    const uint8_t *const PROGMEM macro_table[] = {__VA_ARGS__}; \
+    const uint8_t                macro_table_size = ARRAY_SIZE(macro_table)
+
+extern const uint8_t *const macro_table[];
+extern const uint8_t        macro_table_size;
+
+/** Starts playing a bytecode macro stored in PROGMEM. */
+void macro_play_code_P(const uint8_t *code);
+
+/** Returns true while a macro is playing. */
+bool macro_player_is_playing(void);
+
+/** Stops the macro that is playing, if any, and releases the keys it holds. */
+void macro_player_cancel(void);
+
+/**
+ * Handler function for the macro player. Cancels the playing macro when
+ * another key is pressed, and plays the macro of keys in the macro table.
+ * Returns false for keys in the table.
+ */
+bool process_macro_player(uint16_t keycode, keyrecord_t *record);
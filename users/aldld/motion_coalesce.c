@@ -0,0 +1,138 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "motion_coalesce.h"
+#ifdef PROTOCOL_CHIBIOS
+#    include <ch.h>
+#endif
+
+#define INTERVAL_US (USB_POLLING_INTERVAL_MS * 1000UL)
+// Reports further apart than this are from different movements.
+#define GAP_US (4 * INTERVAL_US)
+
+static motion_coalesce_stats_t stats;
+// Running averages in 1/16 us.
+static uint32_t latency_sum = 0;
+static uint32_t jitter_sum  = 0;
+
+// Motion not sent yet.
+static int16_t  pending_x = 0;
+static int16_t  pending_y = 0;
+static int16_t  pending_h = 0;
+static int16_t  pending_v = 0;
+static bool     pending   = false;
+static uint32_t first_read;
+static uint32_t last_report  = 0;
+static uint8_t  last_buttons = 0;
+
+// Time in us, wrapping. The system timer of the RP2040 counts in us, the
+// timer_read32() millisecond clock is too coarse for a 1 ms interval.
+static uint32_t now_us(void) {
+#ifdef PROTOCOL_CHIBIOS
+    return TIME_I2US(chVTGetSystemTimeX());
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high) {
+    return value < low ? low : value > high ? high : value;
+}
+
+static void add(int16_t *pending, int16_t motion) {
+    *pending = clamp(*pending + motion, INT16_MIN, INT16_MAX);
+}
+
+// Takes what fits in a report out of `pending`.
+static int16_t take(int16_t *pending, int16_t low, int16_t high) {
+    const int16_t motion = clamp(*pending, low, high);
+    *pending -= motion;
+    return motion;
+}
+
+// Adds `sample` to the running average `sum` and to `max`.
+static uint16_t average(uint32_t *sum, uint16_t *max, uint32_t sample) {
+    const uint16_t value = MIN(sample, UINT16_MAX);
+    if (value > *max) {
+        *max = value;
+    }
+    *sum = *sum - *sum / 16 + value;
+    return *sum / 16;
+}
+
+static void measure(uint32_t now) {
+    const uint32_t interval = now - last_report;
+    ++stats.reports;
+    stats.avg_latency = average(&latency_sum, &stats.max_latency, now - first_read);
+    if (stats.reports > 1 && interval < GAP_US) {
+        const uint32_t jitter = interval > INTERVAL_US ? interval - INTERVAL_US : INTERVAL_US - interval;
+        stats.avg_jitter      = average(&jitter_sum, &stats.max_jitter, jitter);
+    }
+}
+
+report_mouse_t motion_coalesce_task(report_mouse_t report) {
+    const uint32_t now = now_us();
+    if (report.x || report.y || report.h || report.v) {
+        ++stats.reads;
+        if (!pending) {
+            pending    = true;
+            first_read = now;
+        }
+        add(&pending_x, report.x);
+        add(&pending_y, report.y);
+        add(&pending_h, report.h);
+        add(&pending_v, report.v);
+    }
+    const bool buttons_changed = report.buttons != last_buttons;
+    last_buttons               = report.buttons;
+
+    report.x = 0;
+    report.y = 0;
+    report.h = 0;
+    report.v = 0;
+    if (!pending || (!buttons_changed && now - last_report < INTERVAL_US - MOTION_COALESCE_SLACK_US)) {
+        return report;
+    }
+    report.x = take(&pending_x, XY_REPORT_MIN, XY_REPORT_MAX);
+    report.y = take(&pending_y, XY_REPORT_MIN, XY_REPORT_MAX);
+    report.h = take(&pending_h, HV_REPORT_MIN, HV_REPORT_MAX);
+    report.v = take(&pending_v, HV_REPORT_MIN, HV_REPORT_MAX);
+    measure(now);
+    last_report = now;
+    // Motion too fast for one report waits for the next, and keeps the time
+    // of its first read.
+    pending = pending_x || pending_y || pending_h || pending_v;
+    return report;
+}
+
+motion_coalesce_stats_t motion_coalesce_get_stats(void) {
+    return stats;
+}
+
+void motion_coalesce_clear(void) {
+    memset(&stats, 0, sizeof(stats));
+    latency_sum = 0;
+    jitter_sum  = 0;
+}
+
+static void put_u16(uint8_t *p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void put_u32(uint8_t *p, uint32_t value) {
+    put_u16(&p[0], value & 0xFFFF);
+    put_u16(&p[2], value >> 16);
+}
+
+void motion_coalesce_read(uint8_t *data, uint8_t length) {
+    if (length < MOTION_COALESCE_REPLY_SIZE) {
+        return;
+    }
+    put_u32(&data[1], stats.reads);
+    put_u32(&data[5], stats.reports);
+    put_u16(&data[9], stats.avg_latency);
+    put_u16(&data[11], stats.max_latency);
+    put_u16(&data[13], stats.avg_jitter);
+    put_u16(&data[15], stats.max_jitter);
+}
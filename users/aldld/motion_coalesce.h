@@ -0,0 +1,92 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file motion_coalesce.h
+ * @brief Merges sensor reads into one mouse report per USB poll.
+ *
+ * QMK sends a mouse report for every sensor read with motion, whenever the
+ * read happens. Reads that come faster than the host polls the endpoint queue
+ * up, and the host then takes reports that are one or more polls old, while
+ * reads that straddle a poll split one movement across reports.
+ *
+ * Instead, the motion of each read is added to a pending report, which is
+ * sent once USB_POLLING_INTERVAL_MS has gone by since the last one, less
+ * MOTION_COALESCE_SLACK_US for the read that is due just before. Read the
+ * sensor more often than the host polls, e.g. with
+ * POINTING_DEVICE_TASK_THROTTLE_MS 0, and the motion sent is from a read just
+ * before the poll. Motion after a pause, and motion with a button change, goes
+ * out right away.
+ *
+ * The time from the first read merged into a report to sending it, and how
+ * far the time between two reports of a movement strays from the polling
+ * interval, are measured. Read them with `motion_coalesce_get_stats()`, or
+ * over raw HID with `tools/hid_tool <device> motion`.
+ *
+ * Enable in rules.mk with:
+ *
+ *     MOTION_COALESCE_ENABLE = yes
+ *
+ * and call `motion_coalesce_task()` first in `pointing_device_task_user()`,
+ * so that the other stages see the motion of a whole report.
+ *
+ * When disabled, `motion_coalesce_task()` returns the report as it is.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+// QMK's default, from usb_descriptor.h.
+#ifndef USB_POLLING_INTERVAL_MS
+#    define USB_POLLING_INTERVAL_MS 1
+#endif
+#ifndef MOTION_COALESCE_SLACK_US
+#    define MOTION_COALESCE_SLACK_US 100
+#endif
+
+typedef struct {
+    // Sensor reads with motion, and reports with motion sent.
+    uint32_t reads;
+    uint32_t reports;
+    // First read to report, in us: running average over about 16 reports, and
+    // the most.
+    uint16_t avg_latency;
+    uint16_t max_latency;
+    // Time between two reports of a movement, less the polling interval, in
+    // us: running average of its magnitude, and the most.
+    uint16_t avg_jitter;
+    uint16_t max_jitter;
+} motion_coalesce_stats_t;
+
+/**
+ * Reply to HID_CMD_MOTION_READ, request [cmd], after the command byte:
+ *
+ *     [1..4] sensor reads with motion
+ *     [5..8] reports with motion
+ *     [9..10] average latency in us
+ *     [11..12] maximum latency in us
+ *     [13..14] average jitter in us
+ *     [15..16] maximum jitter in us
+ */
+#define MOTION_COALESCE_REPLY_SIZE 17
+
+#ifdef MOTION_COALESCE_ENABLE
+/**
+ * Adds the report's motion to the pending report and returns the pending
+ * report if it is due, or the report without motion. Call first in
+ * `pointing_device_task_user()`.
+ */
+report_mouse_t motion_coalesce_task(report_mouse_t report);
+
+/** Returns the measurements. */
+motion_coalesce_stats_t motion_coalesce_get_stats(void);
+
+/** Handles HID_CMD_MOTION_READ, filling in the reply in `data`. */
+void motion_coalesce_read(uint8_t *data, uint8_t length);
+
+/** Resets the measurements. */
+void motion_coalesce_clear(void);
+#else
+#    define motion_coalesce_task(report) (report)
+#endif
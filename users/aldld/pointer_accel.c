@@ -0,0 +1,53 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pointer_accel.h"
+
+// Motion not sent yet, in 1/256 of a count.
+static int16_t remainder_x = 0;
+static int16_t remainder_y = 0;
+
+// Keymaps without curves get a gain of 1.
+__attribute__((weak)) const uint16_t pointer_accel_curves[][POINTER_ACCEL_TABLE_SIZE] = {POINTER_ACCEL_CURVE(256, 256, 1)};
+__attribute__((weak)) const uint8_t  pointer_accel_num_curves = 1;
+__attribute__((weak)) const uint8_t  pointer_accel_layers[]   = {0};
+__attribute__((weak)) const uint8_t  pointer_accel_num_layers = 0;
+
+static uint8_t current_curve(void) {
+    const uint8_t layer = get_highest_layer(layer_state | default_layer_state);
+    if (layer >= pointer_accel_num_layers) {
+        return 0;
+    }
+    const uint8_t curve = pgm_read_byte(&pointer_accel_layers[layer]);
+    return curve < pointer_accel_num_curves ? curve : 0;
+}
+
+static int32_t clamp(int32_t value, int32_t low, int32_t high) {
+    return value < low ? low : value > high ? high : value;
+}
+
+// Scales `motion` by `gain`, adding and updating the remainder.
+static mouse_xy_report_t scale(int16_t *remainder, mouse_xy_report_t motion, uint16_t gain) {
+    const int32_t scaled = (int32_t)motion * gain + *remainder;
+    // Division rounds toward zero, so the remainder keeps the sign of the
+    // motion. Dividing by a power of two needs no divide instruction.
+    const int32_t counts = clamp(scaled / 256, XY_REPORT_MIN, XY_REPORT_MAX);
+    // Motion beyond what fits in a report is dropped, see MOUSE_EXTENDED_REPORT.
+    *remainder = clamp(scaled - counts * 256, -255, 255);
+    return counts;
+}
+
+report_mouse_t pointer_accel_task(report_mouse_t report) {
+    if (report.x == 0 && report.y == 0) {
+        return report;
+    }
+    // Distance covered, within 12%: the larger of |x| and |y| plus half the
+    // smaller.
+    const uint16_t ax    = report.x < 0 ? -report.x : report.x;
+    const uint16_t ay    = report.y < 0 ? -report.y : report.y;
+    const uint16_t speed = ax > ay ? ax + ay / 2 : ay + ax / 2;
+    const uint16_t gain  = pgm_read_word(&pointer_accel_curves[current_curve()][MIN(speed, POINTER_ACCEL_TABLE_SIZE - 1)]);
+    report.x             = scale(&remainder_x, report.x, gain);
+    report.y             = scale(&remainder_y, report.y, gain);
+    return report;
+}
@@ -0,0 +1,101 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file pointer_accel.h
+ * @brief Pointer acceleration from speed-to-gain lookup tables.
+ *
+ * Each report's motion is multiplied by a gain looked up from how fast the
+ * pointer moves, i.e. the motion in the report, up to
+ * POINTER_ACCEL_TABLE_SIZE - 1 counts. Slow motion can be scaled down for
+ * precision and fast motion up to cross the screen. Gains are in 1/256 and
+ * the curves are worked out at compile time into PROGMEM, so each report
+ * costs one table read and a few integer operations. The fraction of a count
+ * left over after scaling carries over to the next report, so that slow
+ * motion isn't rounded away.
+ *
+ * Motion beyond what a report holds after the gain is dropped, rather than
+ * sent after the ball stops. With 8-bit reports, a gain of 2.5 fills one at
+ * about 50 counts, which shortens fast flicks. Define MOUSE_EXTENDED_REPORT
+ * in config.h for 16-bit reports, which hold any gained motion.
+ *
+ * The keymap lists its curves, and the curve used on each layer:
+ *
+ *     POINTER_ACCEL_CURVES(
+ *         [CURVE_NORMAL]  = POINTER_ACCEL_CURVE(256, 640, 12),
+ *         [CURVE_PRECISE] = POINTER_ACCEL_CURVE(96, 256, 24),
+ *     );
+ *     POINTER_ACCEL_LAYERS([0] = CURVE_NORMAL, [1] = CURVE_PRECISE);
+ *
+ * Layers not listed use curve 0. tools/accel_bench measures the cost per
+ * report on the host.
+ *
+ * Enable in rules.mk with:
+ *
+ *     POINTER_ACCEL_ENABLE = yes
+ *
+ * and call `pointer_accel_task()` from `pointing_device_task_user()`, before
+ * anything that reads the motion, such as drag scrolling.
+ *
+ * When disabled, `pointer_accel_task()` returns the report as it is.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#define POINTER_ACCEL_TABLE_SIZE 32
+
+/**
+ * Gain at `speed` counts per report, in 1/256: from `low` when still to
+ * `high` when fast, half way at `mid` counts per report, which must be
+ * greater than 0.
+ */
+#define POINTER_ACCEL_GAIN(speed, low, high, mid) ((low) + ((high) - (low)) * (speed) * (speed) / ((speed) * (speed) + (mid) * (mid)))
+
+// clang-format off
+/** A curve of POINTER_ACCEL_TABLE_SIZE gains, see POINTER_ACCEL_GAIN(). */
+#define POINTER_ACCEL_CURVE(low, high, mid) {                                                                   \
+    POINTER_ACCEL_GAIN(0, low, high, mid),  POINTER_ACCEL_GAIN(1, low, high, mid),                              \
+    POINTER_ACCEL_GAIN(2, low, high, mid),  POINTER_ACCEL_GAIN(3, low, high, mid),                              \
+    POINTER_ACCEL_GAIN(4, low, high, mid),  POINTER_ACCEL_GAIN(5, low, high, mid),                              \
+    POINTER_ACCEL_GAIN(6, low, high, mid),  POINTER_ACCEL_GAIN(7, low, high, mid),                              \
+    POINTER_ACCEL_GAIN(8, low, high, mid),  POINTER_ACCEL_GAIN(9, low, high, mid),                              \
+    POINTER_ACCEL_GAIN(10, low, high, mid), POINTER_ACCEL_GAIN(11, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(12, low, high, mid), POINTER_ACCEL_GAIN(13, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(14, low, high, mid), POINTER_ACCEL_GAIN(15, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(16, low, high, mid), POINTER_ACCEL_GAIN(17, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(18, low, high, mid), POINTER_ACCEL_GAIN(19, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(20, low, high, mid), POINTER_ACCEL_GAIN(21, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(22, low, high, mid), POINTER_ACCEL_GAIN(23, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(24, low, high, mid), POINTER_ACCEL_GAIN(25, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(26, low, high, mid), POINTER_ACCEL_GAIN(27, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(28, low, high, mid), POINTER_ACCEL_GAIN(29, low, high, mid),                             \
+    POINTER_ACCEL_GAIN(30, low, high, mid), POINTER_ACCEL_GAIN(31, low, high, mid),                             \
+}
+// clang-format on
+
+/** Defines the keymap's curves, with designated initializers `[n] = curve`. */
+#define POINTER_ACCEL_CURVES(...)                                                                      \
+    const uint16_t PROGMEM pointer_accel_curves[][POINTER_ACCEL_TABLE_SIZE] = {__VA_ARGS__};           \
+    const uint8_t          pointer_accel_num_curves = ARRAY_SIZE(pointer_accel_curves)
+
+/** Defines the curve of each layer, with designated initializers. */
+#define POINTER_ACCEL_LAYERS(...)                                    \
+    const uint8_t PROGMEM pointer_accel_layers[] = {__VA_ARGS__}; \
+    const uint8_t         pointer_accel_num_layers = ARRAY_SIZE(pointer_accel_layers)
+
+extern const uint16_t pointer_accel_curves[][POINTER_ACCEL_TABLE_SIZE];
+extern const uint8_t  pointer_accel_num_curves;
+extern const uint8_t  pointer_accel_layers[];
+extern const uint8_t  pointer_accel_num_layers;
+
+#ifdef POINTER_ACCEL_ENABLE
+/**
+ * Scales the report's motion by the gain for its speed. Call from
+ * `pointing_device_task_user()`.
+ */
+report_mouse_t pointer_accel_task(report_mouse_t report);
+#else
+#    define pointer_accel_task(report) (report)
+#endif
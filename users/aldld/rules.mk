@@ -0,0 +1,80 @@
+# Shared userspace features, enabled per keymap in its rules.mk.
+
+ifeq ($(strip $(MACRO_PLAYER_ENABLE)), yes)
+    SRC += macro_player.c
+    TIMER_SERVICE_ENABLE = yes
+    OPT_DEFS += -DMACRO_PLAYER_ENABLE
+endif
+
+ifeq ($(strip $(ADAPTIVE_TERM_ENABLE)), yes)
+    SRC += adaptive_term.c
+    OPT_DEFS += -DADAPTIVE_TERM_ENABLE
+    TIMER_SERVICE_ENABLE = yes
+endif
+
+ifeq ($(strip $(COMBO_INDEX_ENABLE)), yes)
+    SRC += combo_index.c
+    OPT_DEFS += -DCOMBO_INDEX_ENABLE
+endif
+
+ifeq ($(strip $(KEYMAP_CACHE_ENABLE)), yes)
+    SRC += keymap_cache.c
+endif
+
+ifeq ($(strip $(DECISION_TRACE_ENABLE)), yes)
+    SRC += decision_trace.c
+    OPT_DEFS += -DDECISION_TRACE_ENABLE
+    HID_COMMANDS_ENABLE = yes
+endif
+
+ifeq ($(strip $(LATENCY_STATS_ENABLE)), yes)
+    SRC += latency_stats.c
+    OPT_DEFS += -DLATENCY_STATS_ENABLE
+    EXTRALDFLAGS += -Wl,--wrap=host_keyboard_send -Wl,--wrap=host_nkro_send
+    HID_COMMANDS_ENABLE = yes
+endif
+
+ifeq ($(strip $(IDLE_MODE_ENABLE)), yes)
+    SRC += idle_mode.c
+    OPT_DEFS += -DIDLE_MODE_ENABLE
+endif
+
+ifeq ($(strip $(LAYER_INDICATOR_ENABLE)), yes)
+    SRC += layer_indicator.c
+    OPT_DEFS += -DLAYER_INDICATOR_ENABLE
+    RGB_MATRIX_CUSTOM_USER = yes
+endif
+
+ifeq ($(strip $(MOTION_COALESCE_ENABLE)), yes)
+    SRC += motion_coalesce.c
+    OPT_DEFS += -DMOTION_COALESCE_ENABLE
+endif
+
+ifeq ($(strip $(DRAG_SCROLL_ENABLE)), yes)
+    SRC += drag_scroll.c
+    OPT_DEFS += -DDRAG_SCROLL_ENABLE
+endif
+
+ifeq ($(strip $(POINTER_ACCEL_ENABLE)), yes)
+    SRC += pointer_accel.c
+    OPT_DEFS += -DPOINTER_ACCEL_ENABLE
+endif
+
+ifeq ($(strip $(DANCE_ENABLE)), yes)
+    SRC += dance.c
+    TIMER_SERVICE_ENABLE = yes
+endif
+
+ifeq ($(strip $(TIMER_SERVICE_ENABLE)), yes)
+    SRC += timer_service.c
+    OPT_DEFS += -DTIMER_SERVICE_ENABLE
+endif
+
+# Raw HID commands for the host tools in tools/hid_tool.
+ifeq ($(strip $(HID_COMMANDS_ENABLE)), yes)
+    ifeq ($(strip $(ORYX_ENABLE)), yes)
+        $(error Raw HID is used by Oryx. Set ORYX_ENABLE = no to use the HID commands)
+    endif
+    SRC += hid_commands.c
+    RAW_ENABLE = yes
+endif
@@ -0,0 +1,135 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "timer_service.h"
+
+_Static_assert(TIMER_SERVICE_MAX_TIMERS < UINT8_MAX, "TIMER_SERVICE_MAX_TIMERS must be less than 255");
+
+#define NO_TIMER UINT8_MAX
+
+typedef struct {
+    uint32_t         deadline;
+    timer_callback_t callback;
+    void            *arg;
+    timer_token_t    token; // TIMER_SERVICE_INVALID_TOKEN when the slot is free.
+    uint8_t          next;  // Next pending timer by deadline.
+} timer_slot_t;
+
+static timer_slot_t timers[TIMER_SERVICE_MAX_TIMERS];
+// The pending timer with the earliest deadline, and its deadline.
+static uint8_t  first         = NO_TIMER;
+static uint32_t next_deadline = 0;
+// The timer whose callback is running, if any. It is off the list meanwhile.
+static uint8_t       running    = NO_TIMER;
+static timer_token_t last_token = TIMER_SERVICE_INVALID_TOKEN;
+
+// Returns true if deadline `a` comes before `b`. Both are within 2^31 ms of
+// the time, so their difference tells their order even if the timer wrapped
+// in between.
+static bool is_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+// Adds a timer to the list, after the timers with the same deadline.
+static void insert(uint8_t i) {
+    uint8_t *link = &first;
+    while (*link != NO_TIMER && !is_before(timers[i].deadline, timers[*link].deadline)) {
+        link = &timers[*link].next;
+    }
+    timers[i].next = *link;
+    *link          = i;
+    next_deadline  = timers[first].deadline;
+}
+
+static void unlink(uint8_t i) {
+    for (uint8_t *link = &first; *link != NO_TIMER; link = &timers[*link].next) {
+        if (*link == i) {
+            *link = timers[i].next;
+            break;
+        }
+    }
+    if (first != NO_TIMER) {
+        next_deadline = timers[first].deadline;
+    }
+}
+
+static int8_t find(timer_token_t token) {
+    if (token == TIMER_SERVICE_INVALID_TOKEN) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < TIMER_SERVICE_MAX_TIMERS; ++i) {
+        if (timers[i].token == token) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static timer_token_t new_token(void) {
+    do {
+        ++last_token;
+    } while (last_token == TIMER_SERVICE_INVALID_TOKEN || find(last_token) >= 0);
+    return last_token;
+}
+
+timer_token_t timer_service_start(uint32_t delay_ms, timer_callback_t callback, void *arg) {
+    for (uint8_t i = 0; i < TIMER_SERVICE_MAX_TIMERS; ++i) {
+        if (timers[i].token == TIMER_SERVICE_INVALID_TOKEN) {
+            timers[i].deadline = timer_read32() + delay_ms;
+            timers[i].callback = callback;
+            timers[i].arg      = arg;
+            timers[i].token    = new_token();
+            insert(i);
+            return timers[i].token;
+        }
+    }
+    return TIMER_SERVICE_INVALID_TOKEN;
+}
+
+bool timer_service_cancel(timer_token_t token) {
+    const int8_t i = find(token);
+    if (i < 0) {
+        return false;
+    }
+    // A running timer is off the list already; freeing its slot keeps it
+    // from being added back.
+    if (i != running) {
+        unlink(i);
+    }
+    timers[i].token = TIMER_SERVICE_INVALID_TOKEN;
+    return true;
+}
+
+bool timer_service_is_pending(timer_token_t token) {
+    return find(token) >= 0;
+}
+
+void timer_service_task(void) {
+    if (first == NO_TIMER) {
+        return;
+    }
+    const uint32_t now = timer_read32();
+    // Repeating timers go back on the list due after `now`, so this ends.
+    while (first != NO_TIMER && !is_before(now, next_deadline)) {
+        const uint8_t       i     = first;
+        const timer_token_t token = timers[i].token;
+        unlink(i);
+        running              = i;
+        const uint32_t delay = timers[i].callback(timers[i].deadline, timers[i].arg);
+        running              = NO_TIMER;
+        if (timers[i].token != token) {
+            continue; // Cancelled by its callback, which may have reused the slot.
+        }
+        if (delay == 0) {
+            timers[i].token = TIMER_SERVICE_INVALID_TOKEN;
+            continue;
+        }
+        timers[i].deadline += delay;
+        // A timer that fell behind by more than its delay catches up once,
+        // rather than once per missed period.
+        if (!is_before(now, timers[i].deadline)) {
+            timers[i].deadline = now + delay;
+        }
+        insert(i);
+    }
+}
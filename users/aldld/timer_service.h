@@ -0,0 +1,79 @@
+// Copyright 2026 @aldld
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/**
+ * @file timer_service.h
+ * @brief One sorted list of deadlines for every userspace timeout.
+ *
+ * Features that wait for something register a callback with a delay instead
+ * of checking `timer_elapsed()` on every scan:
+ *
+ *     static uint32_t save_stats(uint32_t deadline, void *arg) {
+ *         ...
+ *         return SAVE_INTERVAL; // Runs again after SAVE_INTERVAL ms.
+ *     }
+ *
+ *     timer_service_start(SAVE_INTERVAL, save_stats, NULL);
+ *
+ * Pending timers are kept sorted by deadline, so `timer_service_task()`
+ * compares the time with the earliest deadline only, and timers that are due
+ * together run in deadline order, and in the order they were started for equal
+ * deadlines. Deadlines are 32-bit, from `timer_read32()`, and compared as
+ * differences, so they are safe across the timer wrapping for delays of up to
+ * about 24 days.
+ *
+ * A callback returns 0 to stop, or the delay after which it runs again. The
+ * new deadline counts from the old one, not from when the callback ran, so
+ * a repeating timer doesn't drift.
+ *
+ * Enable in rules.mk with:
+ *
+ *     TIMER_SERVICE_ENABLE = yes
+ *
+ * (features that use it enable it themselves) and call `timer_service_task()`
+ * from `housekeeping_task_user()`.
+ *
+ * When disabled, `timer_service_task()` compiles to nothing.
+ */
+
+#pragma once
+
+#include "quantum.h"
+
+#ifndef TIMER_SERVICE_MAX_TIMERS
+#    define TIMER_SERVICE_MAX_TIMERS 8
+#endif
+
+/** Identifies a started timer. Never TIMER_SERVICE_INVALID_TOKEN. */
+typedef uint8_t timer_token_t;
+
+#define TIMER_SERVICE_INVALID_TOKEN 0
+
+/**
+ * Callback run when a timer is due, with the timer's deadline and the
+ * argument it was started with. Returns the delay in ms until it runs again,
+ * or 0 to stop.
+ */
+typedef uint32_t (*timer_callback_t)(uint32_t deadline, void *arg);
+
+#ifdef TIMER_SERVICE_ENABLE
+/**
+ * Runs `callback` after `delay_ms`. Returns TIMER_SERVICE_INVALID_TOKEN if
+ * TIMER_SERVICE_MAX_TIMERS timers are already pending.
+ */
+timer_token_t timer_service_start(uint32_t delay_ms, timer_callback_t callback, void *arg);
+
+/**
+ * Cancels a pending timer. Returns false if it already stopped. A callback
+ * may cancel its own timer, which then doesn't run again.
+ */
+bool timer_service_cancel(timer_token_t token);
+
+/** Returns true while the timer is pending or its callback is running. */
+bool timer_service_is_pending(timer_token_t token);
+
+/** Runs the callbacks that are due. Call from `housekeeping_task_user()`. */
+void timer_service_task(void);
+#else
+#    define timer_service_task()
+#endif